@@ -0,0 +1,96 @@
+/**
+ * @file arena.c
+ * @author Diogo Lobo (ist1109293)
+ * @brief Implementação da arena de rascunho usada para os valores
+ * temporários de cada comando.
+ * @date 2026-10-16
+ */
+
+#include <stdlib.h>
+#include "arena.h"
+
+/**
+ * @brief Aloca um novo bloco para a arena.
+ * 
+ * @param capacity A capacidade do bloco em bytes.
+ * @param next O bloco que fica antes do novo bloco.
+ * 
+ * @return O novo bloco, ou NULL se a alocação falhar.
+ */
+ArenaBlock* newArenaBlock(size_t capacity, ArenaBlock *next) {
+	ArenaBlock *block = (ArenaBlock*)malloc(sizeof(ArenaBlock) + capacity);
+	if (block == NULL) return NULL;
+	block->next = next;
+	block->capacity = capacity;
+	block->used = 0;
+	return block;
+}
+
+/**
+ * @brief Inicializa uma arena com um bloco da capacidade indicada.
+ * 
+ * @param arena A arena a inicializar.
+ * @param capacity A capacidade inicial em bytes.
+ * 
+ * @return 1 em caso de sucesso, 0 se a alocação falhar.
+ */
+int initArena(Arena *arena, size_t capacity) {
+	arena->current = newArenaBlock(capacity, NULL);
+	return arena->current != NULL;
+}
+
+/**
+ * @brief Reserva memória na arena. Quando o bloco atual não chega, é criado
+ * um bloco com pelo menos o dobro da capacidade, sem mover as alocações
+ * anteriores.
+ * 
+ * @param arena A arena.
+ * @param size O número de bytes pretendido.
+ * 
+ * @return Um ponteiro para a memória reservada, ou NULL se a alocação falhar.
+ */
+void* arenaAlloc(Arena *arena, size_t size) {
+	ArenaBlock *block = arena->current;
+	size_t capacity;
+	void *memory;
+	size = (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+	if (block->capacity - block->used < size) {
+		capacity = block->capacity * 2;
+		while (capacity < size) capacity *= 2;
+		block = newArenaBlock(capacity, block);
+		if (block == NULL) return NULL;
+		arena->current = block;
+	}
+	memory = block->data + block->used;
+	block->used += size;
+	return memory;
+}
+
+/**
+ * @brief Libera todas as alocações da arena. Os blocos menores são
+ * devolvidos ao sistema e o maior é mantido para o comando seguinte.
+ * 
+ * @param arena A arena a reinicializar.
+ */
+void resetArena(Arena *arena) {
+	ArenaBlock *block = arena->current->next, *next;
+	while (block != NULL) {
+		next = block->next;
+		free(block);
+		block = next;
+	}
+	arena->current->next = NULL;
+	arena->current->used = 0;
+}
+
+/**
+ * @brief Libera toda a memória da arena.
+ * 
+ * @param arena A arena a destruir.
+ */
+void destroyArena(Arena *arena) {
+	if (arena->current == NULL) return;
+	resetArena(arena);
+	free(arena->current);
+	arena->current = NULL;
+}
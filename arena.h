@@ -0,0 +1,41 @@
+/**
+ * @file arena.h
+ * @author Diogo Lobo (ist1109293)
+ * @brief Cabeçalho da arena de rascunho. A arena entrega memória por avanço
+ * de um ponteiro dentro de blocos grandes e é esvaziada de uma só vez no fim
+ * de cada comando, o que dispensa liberar um a um os valores temporários
+ * criados durante a análise da entrada.
+ * @date 2026-10-16
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/** Alinhamento, em bytes, de cada alocação feita na arena. */
+#define ARENA_ALIGNMENT 8
+
+/** Estrutura que representa um bloco de memória de uma arena. */
+typedef struct ArenaBlock {
+    struct ArenaBlock *next; /** Bloco anterior, menor. */
+    size_t capacity; /** Capacidade do bloco em bytes. */
+    size_t used; /** Número de bytes já entregues. */
+    char data[]; /** Memória do bloco. */
+} ArenaBlock;
+
+/** Estrutura que representa uma arena de rascunho. O bloco atual é sempre o
+ * maior; os anteriores só existem até à próxima reinicialização. */
+typedef struct Arena {
+    ArenaBlock *current; /** Bloco onde são feitas as alocações. */
+} Arena;
+
+int initArena(Arena *arena, size_t capacity);
+
+void* arenaAlloc(Arena *arena, size_t size);
+
+void resetArena(Arena *arena);
+
+void destroyArena(Arena *arena);
+
+#endif
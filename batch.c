@@ -3,12 +3,10 @@
  * @author Diogo Lobo (ist1109293)
  * @brief Implementação de funções para gerenciamento de lotes 
  * de vacinas em umsistema de vacinação. Inclui operações como 
- * inserção, remoção, busca, redimensionamento da tabela hash, 
- * e listagem dos lotes.
+ * inserção, remoção, busca e listagem dos lotes.
  * @date 2025-04-07
  */
 
-#include <stdio.h>
 #include <ctype.h>
 #include <string.h>
 #include <stdlib.h>
@@ -18,80 +16,44 @@
 #include "utils.h"
 
 /**
- * @brief Calcula o índice de hash para um identificador de lote.
- * Utiliza um algoritmo multiplicativo para calcular o valor de hash.
+ * @brief Devolve a chave de um lote na tabela de hash, o seu ID.
  * 
- * @param v O identificador do lote (batch_id).
- * @param table_size O tamanho da tabela hash.
+ * @param entry O lote (BatchInfo).
  * 
- * @return O índice calculado para o identificador do lote na tabela hash.
+ * @return O ID do lote.
  */
-int hash(const char *v, int table_size) {
-	int h = 0, a = 127;
-	for (; *v != '\0'; v++)
-		h = (a * h + *v) % table_size;
-	return h;
-}
-
-/**
- * @brief Redimensiona a tabela hash de lotes para um tamanho maior.
- * Caso a carga da tabela atinja o fator máximo, a tabela é redimensionada
- * para o valor do próximo número primo, ou até o tamanho máximo permitido.
- * 
- * @param ht A tabela hash que armazena os lotes de vacina.
- * 
- * @return Retorna 1 se a tabela foi redimensionada com sucesso, ou 0
- * caso ocorra um erro de alocação de memória.
- */
-int resizeBatchesHashTable(BatchesHashTable *ht) {
-	unsigned int new_key;
-	Batches *next;
-	int new_size;
-	if (ht->size == MAX_TABLE_SIZE) return 1;
-	new_size = nextPrime(ht->size * 2);
-	if (new_size > MAX_TABLE_SIZE) new_size = MAX_TABLE_SIZE;
-	Batches **new_buckets = (Batches **)malloc(new_size*sizeof(Batches *));
-	if (new_buckets == NULL) return 0;
-	for (int i = 0; i < new_size; i++) new_buckets[i] = NULL;
-	for (int i = 0; i < ht->size; i++) {
-		Batches *current = ht->batches[i];
-		while (current) {
-			next = current->next;
-			new_key = hash(current->batch_id, new_size);
-			current->next = new_buckets[new_key];
-			new_buckets[new_key] = current;
-			current = next;
-		}
-	}
-	free(ht->batches);
-	ht->batches = new_buckets;
-	ht->size = new_size;
-	return 1;
+const char* batchKey(const void *entry) {
+	return ((const BatchInfo*)entry)->batch;
 }
 
 /**
  * @brief Inicializa uma nova tabela hash para armazenar lotes de vacina.
- * Aloca memória para a tabela hash e seus elementos, e define o tamanho 
- * inicial da tabela e o contador de lotes.
+ * Aloca memória para a tabela hash e o catálogo de vacinas.
+ * 
+ * @param max_batches O número máximo de lotes no sistema, ou 0 para não 
+ * haver limite.
  * 
  * @return Retorna um ponteiro para a nova tabela hash de lotes, ou NULL 
  * caso ocorra um erro de alocação de memória.
  */
-BatchesHashTable* initBatchesHashTable() {
-	int i;
+BatchesHashTable* initBatchesHashTable(int max_batches) {
 	BatchesHashTable *batchHashTable;
 	batchHashTable = (BatchesHashTable *)malloc(sizeof(BatchesHashTable));
 	if (!batchHashTable) return NULL;
-	batchHashTable->batches = (Batches**)malloc(INITIAL_TABLE_SIZE * 
-		sizeof(Batches*));
-	if (!batchHashTable->batches) {
+	if (!initHashTable(&batchHashTable->batches, batchKey)) {
 		free(batchHashTable);
 		return NULL;
 	}
-	for (i = 0; i < INITIAL_TABLE_SIZE; i++)
-		batchHashTable->batches[i] = NULL;
-	batchHashTable->batch_count = 0;
-	batchHashTable->size = INITIAL_TABLE_SIZE;
+	batchHashTable->vaccines = initVaccinesHashTable();
+	if (!batchHashTable->vaccines) {
+		destroyHashTable(&batchHashTable->batches);
+		free(batchHashTable);
+		return NULL;
+	}
+	initBatchIndex(&batchHashTable->batch_index, BATCH_INDEX_ALL_LANE);
+	initBatchHeap(&batchHashTable->expiry, BATCH_HEAP_EXPIRY_LANE);
+	initRetireList(&batchHashTable->retired, NULL);
+	batchHashTable->max_batches = max_batches;
 	return batchHashTable;
 }
 
@@ -100,18 +62,81 @@ BatchesHashTable* initBatchesHashTable() {
  * 
  * @param batchHashTable A tabela hash que armazena os lotes de vacina.
  * 
- * @return Retorna 1 se o número de lotes for maior ou igual ao limite máximo, 
- * caso contrário, retorna 0.
+ * @return Retorna 1 se houver limite e o número de lotes for maior ou igual 
+ * a ele, caso contrário, retorna 0.
  */
 int tooManyBatchesInSystem(BatchesHashTable *batchHashTable) {
-	return batchHashTable->batch_count >= MAX_BATCHES_NUMBER;
+	return batchHashTable->max_batches > 0 && 
+		batchHashTable->batches.count >= 
+		(size_t)batchHashTable->max_batches;
+}
+
+/**
+ * @brief Coloca um lote na heap de lotes utilizáveis da sua vacina e na 
+ * heap de validade do sistema.
+ * 
+ * @param batchHashTable A tabela hash que armazena os lotes de vacina.
+ * @param vaccine A vacina do lote.
+ * @param batch O lote.
+ * 
+ * @return Retorna 1 se a operação foi bem-sucedida, caso contrário, retorna 0, 
+ * sem o lote em nenhuma das heaps.
+ */
+int scheduleBatch(BatchesHashTable *batchHashTable, Vaccine *vaccine, 
+	BatchInfo *batch) {
+	if (!pushBatchToVaccine(vaccine, batch)) return 0;
+	if (!pushToBatchHeap(&batchHashTable->expiry, batch)) {
+		removeBatchFromVaccine(vaccine, batch);
+		return 0;
+	}
+	return 1;
+}
+
+/**
+ * @brief Associa um lote à sua vacina no catálogo de vacinas, insere-o nos 
+ * índices ordenados de lotes e, se tiver doses, coloca-o na heap de lotes 
+ * utilizáveis dessa vacina e na heap de validade.
+ * 
+ * @param batchHashTable A tabela hash que armazena os lotes de vacina.
+ * @param batch O lote a indexar.
+ * @param vaccine_name O nome da vacina do lote.
+ * 
+ * @return Retorna 1 se a operação foi bem-sucedida, caso contrário, retorna 0.
+ */
+int indexBatchByVaccine(BatchesHashTable *batchHashTable, BatchInfo *batch, 
+	const char *vaccine_name) {
+	Vaccine *vaccine;
+	batch->heap_index[BATCH_HEAP_VACCINE_LANE] = -1;
+	batch->heap_index[BATCH_HEAP_EXPIRY_LANE] = -1;
+	vaccine = getOrInsertVaccine(batchHashTable->vaccines, vaccine_name);
+	if (!vaccine) return 0;
+	batch->vaccine_id = vaccine->id;
+	if (batch->doses > 0 && !scheduleBatch(batchHashTable, vaccine, batch))
+		return 0;
+	insertInBatchIndex(&batchHashTable->batch_index, batch);
+	insertInBatchIndex(&vaccine->batches, batch);
+	vaccine->stock.doses += batch->doses;
+	return 1;
+}
+
+/**
+ * @brief Devolve a vacina de um lote.
+ * 
+ * @param batchHashTable A tabela hash que armazena os lotes de vacina.
+ * @param batch_info O lote.
+ * 
+ * @return A vacina do lote no catálogo de vacinas.
+ */
+Vaccine* vaccineOfBatch(BatchesHashTable *batchHashTable, 
+	BatchInfo *batch_info) {
+	return vaccineById(batchHashTable->vaccines, batch_info->vaccine_id);
 }
 
 /**
  * @brief Insere um novo lote de vacina no sistema.
  * 
  * @param batchHashTable A tabela hash que armazena os lotes de vacina.
- * @param batch_id O identificador do lote a ser inserido.
+ * @param batch_id O identificador do lote a ser inserido, já validado.
  * @param date A data de fabricação do lote.
  * @param doses O número de doses disponíveis no lote.
  * @param vaccine_name O nome da vacina do lote.
@@ -120,30 +145,61 @@ int tooManyBatchesInSystem(BatchesHashTable *batchHashTable) {
  */
 int insertBatchInSystem(BatchesHashTable *batchHashTable, const char *batch_id, 
 	Date date, int doses, const char *vaccine_name) {
-	Batches *new_node;
 	BatchInfo *batch;
-	unsigned int key;
-	if ((float)batchHashTable->batch_count / batchHashTable->size 
-	>= MAX_LOAD_FACTOR) {
-		if (resizeBatchesHashTable(batchHashTable) == 0) return 0;
+	int level;
+	level = randomBatchIndexLevel(&batchHashTable->batch_index);
+	batch = (BatchInfo *)malloc(sizeof(BatchInfo) + 
+		BATCH_INDEX_LANES * level * sizeof(BatchInfo *));
+	if (!batch) return 0;
+	strcpy(batch->batch, batch_id);
+	packBatchKey(batch_id, &batch->key);
+	batch->date = date;
+	batch->doses = doses;
+	batch->applications = 0;
+	batch->level = level;
+	if (!hashTableInsert(&batchHashTable->batches, batch)) {
+		free(batch);
+		return 0;
 	}
-	key = hash(batch_id, batchHashTable->size);
-	new_node = (Batches *)malloc(sizeof(Batches));
-	if (!new_node) return 0;
-	batch = (BatchInfo *)malloc(sizeof(BatchInfo));
-	if (!batch) {
-		free(new_node);
+	if (!indexBatchByVaccine(batchHashTable, batch, vaccine_name)) {
+		hashTableRemove(&batchHashTable->batches, batch_id);
+		free(batch);
 		return 0;
 	}
-	batch->batch = strdup(batch_id);
-	batch->date = date;
-	batch->doses = doses, batch->vaccine_name = strdup(vaccine_name);
-	batch->applications = 0;
-	new_node->batch_id = strdup(batch_id);
-	new_node->batch_info = batch;
-	new_node->next = batchHashTable->batches[key];
-	batchHashTable->batches[key] = new_node;
-	batchHashTable->batch_count++;
+	return 1;
+}
+
+/**
+ * @brief Repõe um lote lido de um snapshot, com as doses já aplicadas. O 
+ * lote só fica utilizável pela sua vacina se ainda tiver doses disponíveis.
+ * Um lote retirado guardado com menos doses do que aplicações fica com o 
+ * total das aplicações, como os lotes retirados agora.
+ * 
+ * @param batchHashTable A tabela hash que armazena os lotes de vacina.
+ * @param batch_id O identificador do lote.
+ * @param date A data de validade do lote.
+ * @param doses O número total de doses do lote.
+ * @param applications O número de doses já aplicadas.
+ * @param vaccine_name O nome da vacina do lote.
+ * 
+ * @return Retorna 1 se a operação foi bem-sucedida, caso contrário, 
+ * retorna 0.
+ */
+int restoreBatchInSystem(BatchesHashTable *batchHashTable, 
+	const char *batch_id, Date date, int doses, int applications, 
+	const char *vaccine_name) {
+	BatchInfo *batch;
+	Vaccine *vaccine;
+	if (doses < applications) doses = applications;
+	if (!insertBatchInSystem(batchHashTable, batch_id, date, doses, 
+		vaccine_name)) return 0;
+	batch = searchBatchInSystem(batchHashTable, batch_id);
+	vaccine = vaccineOfBatch(batchHashTable, batch);
+	removeBatchFromVaccine(vaccine, batch);
+	batch->applications = applications;
+	vaccine->stock.applications += applications;
+	if (doses - applications > 0 && !pushBatchToVaccine(vaccine, batch))
+		return 0;
 	return 1;
 }
 
@@ -155,17 +211,9 @@ int insertBatchInSystem(BatchesHashTable *batchHashTable, const char *batch_id,
  * 
  * @return Um ponteiro para o lote se encontrado, caso contrário NULL.
  */
-Batches* searchBatchInSystem(BatchesHashTable *batchHashTable, 
+BatchInfo* searchBatchInSystem(BatchesHashTable *batchHashTable, 
 	const char *batch_id) {
-	unsigned int key = hash(batch_id, batchHashTable->size);
-	Batches *current = batchHashTable->batches[key];
-	while (current) {
-		if (strcmp(current->batch_id, batch_id) == 0) {
-			return current;
-		}
-		current = current->next;
-	}
-	return NULL;
+	return hashTableFind(&batchHashTable->batches, batch_id);
 }
 
 /**
@@ -173,6 +221,7 @@ Batches* searchBatchInSystem(BatchesHashTable *batchHashTable,
  * lote com o mesmo ID no sistema.
  * 
  * @param batchHashTable A tabela de hash que armazena os lotes de vacinas.
+ * @param out O escritor de saída onde o erro é escrito.
  * @param batch_id O ID do lote a ser verificado.
  * @param pt Um valor que indica se o programa deve imprimir as mensagens de 
  * erro em português ou não.
@@ -180,25 +229,57 @@ Batches* searchBatchInSystem(BatchesHashTable *batchHashTable,
  * @return 1 se o número do lote for válido (não duplicado), 0 se for inválido 
  * (duplicado).
  */
-int validBatchNumber(BatchesHashTable *batchHashTable, const char *batch_id, 
-	int pt) {
+int validBatchNumber(BatchesHashTable *batchHashTable, Output *out, 
+	const char *batch_id, int pt) {
 	if (searchBatchInSystem(batchHashTable, batch_id) != NULL) {
-		printError(EDUPLICATEBATCHNUMBER, EDUPLICATEBATCHNUMBERPT, pt);
+		printError(out, EDUPLICATEBATCHNUMBER, EDUPLICATEBATCHNUMBERPT, 
+			pt);
 		return 0;
 	}
 	return 1;
 }
 
 /**
- * @brief Troca os valores de dois ponteiros para estruturas `BatchInfo`.
+ * @brief Devolve o valor de um dígito hexadecimal maiúsculo.
  * 
- * @param a Ponteiro para o primeiro `BatchInfo`.
- * @param b Ponteiro para o segundo `BatchInfo`.
+ * @param digit O dígito.
+ * 
+ * @return O valor, entre 0 e 15.
  */
-void swapBatches(BatchInfo **a, BatchInfo **b) {
-	BatchInfo *temp = *a;
-	*a = *b;
-	*b = temp;
+int hexDigitValue(char digit) {
+	return digit <= '9' ? digit - '0' : digit - 'A' + 10;
+}
+
+/**
+ * @brief Compacta o ID de um lote, com meio byte por dígito. Como os 
+ * dígitos valem por ordem alfabética e os que faltam valem zero, comparar 
+ * os bytes e desempatar pelo número de dígitos dá a ordem do `strcmp`.
+ * 
+ * @param batch_id O ID do lote, com dígitos hexadecimais maiúsculos.
+ * @param key A chave a preencher.
+ */
+void packBatchKey(const char *batch_id, BatchKey *key) {
+	int i, shift;
+	memset(key, 0, sizeof(BatchKey));
+	for (i = 0; batch_id[i] != '\0'; i++) {
+		shift = i % 2 == 0 ? 4 : 0;
+		key->digits[i / 2] |= 
+			(unsigned char)(hexDigitValue(batch_id[i]) << shift);
+	}
+	key->length = (unsigned char)i;
+}
+
+/**
+ * @brief Compara dois IDs de lotes compactados.
+ * 
+ * @param key1 A primeira chave.
+ * @param key2 A segunda chave.
+ * 
+ * @return Um valor negativo, zero ou positivo, como o `strcmp` dos IDs.
+ */
+int compareBatchKeys(const BatchKey *key1, const BatchKey *key2) {
+	int cmp = memcmp(key1->digits, key2->digits, BATCH_KEY_SIZE);
+	return cmp != 0 ? cmp : key1->length - key2->length;
 }
 
 /**
@@ -213,177 +294,282 @@ void swapBatches(BatchInfo **a, BatchInfo **b) {
 int compareBatches(BatchInfo *batch1, BatchInfo *batch2) {
 	int date_cmp = compareDate1Date2(batch1->date, batch2->date);
 	if (date_cmp != 0) return date_cmp;
-	return strcmp(batch1->batch, batch2->batch);
+	return compareBatchKeys(&batch1->key, &batch2->key);
 }
 
 /**
- * @brief Particiona o array de lotes para o algoritmo de ordenação rápido 
- * (quicksort).
- * 
- * @param batches O array de `BatchInfo` a ser particionado.
- * @param low O índice inicial do array a ser particionado.
- * @param high O índice final do array a ser particionado.
+ * @brief Guarda o estado atual de um lote: as doses disponíveis e aplicadas 
+ * e o nome da vacina.
  * 
- * @return O índice da posição de partição no array após a reorganização.
+ * @param batchHashTable A tabela de hash que armazena os lotes de vacinas.
+ * @param batch_info O lote.
+ * @param view O estado a preencher.
  */
-int partitionBatches(BatchInfo **batches, int low, int high) {
-	BatchInfo *pivot = batches[high];
-	int i = low - 1;
-	for (int j = low; j < high; j++) {
-		if (compareBatches(batches[j], pivot) < 0) {  
-			i++;
-			swapBatches(&batches[i], &batches[j]);
-		}
-	}
-	swapBatches(&batches[i + 1], &batches[high]);
-	return i + 1;
+void viewBatch(BatchesHashTable *batchHashTable, BatchInfo *batch_info, 
+	BatchView *view) {
+	view->batch = batch_info;
+	view->vaccine_name = vaccineOfBatch(batchHashTable, batch_info)->name;
+	view->available = batch_info->doses - batch_info->applications;
+	if (view->available < 0) view->available = 0;
+	view->applications = batch_info->applications;
 }
 
 /**
- * @brief Realiza a ordenação rápida (quicksort) no array de lotes.
+ * @brief Imprime o estado de um lote guardado por `viewBatch`.
  * 
- * @param batches O array de `BatchInfo` a ser ordenado.
- * @param low O índice inicial do array a ser ordenado.
- * @param high O índice final do array a ser ordenado.
+ * @param out O escritor de saída onde o lote é impresso.
+ * @param view O estado do lote.
  */
-void quicksortBatches(BatchInfo **batches, int low, int high) {
-	if (low < high) {
-		int pivotIndex = partitionBatches(batches, low, high);
-		quicksortBatches(batches, low, pivotIndex - 1);
-		quicksortBatches(batches, pivotIndex + 1, high);
-	}
+void printBatchView(Output *out, const BatchView *view) {
+	outputString(out, view->vaccine_name);
+	outputChar(out, ' ');
+	outputString(out, view->batch->batch);
+	outputChar(out, ' ');
+	outputDate(out, view->batch->date);
+	outputChar(out, ' ');
+	outputInt(out, view->available);
+	outputChar(out, ' ');
+	outputInt(out, view->applications);
+	outputChar(out, '\n');
 }
 
 /**
  * @brief Imprime as informações de um lote.
  * 
+ * @param batchHashTable A tabela de hash que armazena os lotes de vacinas.
+ * @param out O escritor de saída onde o lote é impresso.
  * @param batch_info A estrutura `BatchInfo` contendo as informações do lote a 
  * ser impresso.
  */
-void printBatch(BatchInfo* batch_info) {
-	int doses_available;
-	doses_available = batch_info->doses - batch_info->applications;
-	if (doses_available < 0) doses_available = 0;
-	printf("%s %s %02d-%02d-%04d %d %d\n", 
-		batch_info->vaccine_name, batch_info->batch,
-		batch_info->date->day, batch_info->date->month, 
-		batch_info->date->year, doses_available, 
-		batch_info->applications);
+void printBatch(BatchesHashTable *batchHashTable, Output *out, 
+	BatchInfo* batch_info) {
+	BatchView view;
+	viewBatch(batchHashTable, batch_info, &view);
+	printBatchView(out, &view);
 }
 
 /**
- * @brief Imprime as informações de todos os lotes fornecidos na lista.
+ * @brief Guarda o estado atual de todos os lotes, ordenados por data e ID.
  * 
- * @param batches A lista de ponteiros para os lotes a serem impressos.
- * @param batches_count O número total de lotes na lista.
+ * @param batchHashTable A tabela de hash que armazena os lotes de vacinas.
+ * @param views O vetor a preencher, com espaço para todos os lotes.
+ * 
+ * @return O número de lotes.
  */
-void printBatches(BatchInfo** batches, int batches_count) {
-	for (int i = 0; i < batches_count; i++) {
-		printBatch(batches[i]);
-	}
-	free(batches);
+size_t viewAllBatches(BatchesHashTable *batchHashTable, BatchView *views) {
+	BatchIndex *index = &batchHashTable->batch_index;
+	BatchInfo *batch_info;
+	size_t count = 0;
+	for (batch_info = firstInBatchIndex(index); batch_info; 
+		batch_info = nextInBatchIndex(index, batch_info))
+		viewBatch(batchHashTable, batch_info, &views[count++]);
+	return count;
 }
 
 /**
- * @brief Lista todos os lotes presentes no sistema, ordenados por data e ID.
+ * @brief Lista todos os lotes presentes no sistema, ordenados por data e ID, 
+ * percorrendo o índice ordenado de lotes.
  * 
  * @param batchHashTable A tabela de hash que armazena os lotes de vacinas.
+ * @param out O escritor de saída onde os lotes são impressos.
+ */
+void listAllBatchesInSystem(BatchesHashTable *batchHashTable, Output *out) {
+	BatchIndex *index = &batchHashTable->batch_index;
+	BatchInfo *batch_info;
+	for (batch_info = firstInBatchIndex(index); batch_info; 
+		batch_info = nextInBatchIndex(index, batch_info))
+		printBatch(batchHashTable, out, batch_info);
+}
+
+/**
+ * @brief Lista, pela ordem de `l`, os lotes com data de validade anterior à 
+ * data indicada. O fim do intervalo é encontrado no índice ordenado em tempo 
+ * logarítmico, pelo que só são percorridos os lotes listados.
  * 
- * @return 1 se os lotes foram listados com sucesso, 0 em caso de erro.
- */
-int listAllBatchesInSystem(BatchesHashTable *batchHashTable) {
-	BatchInfo** batches_info, *batchInfo;
-	Batches* current;
-	int batches_count, i;
-	batches_info = (BatchInfo**)malloc(sizeof(BatchInfo*)*
-	batchHashTable->batch_count);
-	if (batches_info == NULL) return 0;
-	batches_count = 0;
-	for (i = 0; i < batchHashTable->size; i++) {
-		current = batchHashTable->batches[i];
-		while (current) {
-			batchInfo = current->batch_info;
-			if (batchInfo) batches_info[batches_count++] = 
-			current->batch_info;
-			current = current->next;
-		}
-	}
-	quicksortBatches(batches_info, 0, batches_count - 1);
-	printBatches(batches_info, batches_count);
-	return 1;
+ * @param batchHashTable A tabela de hash que armazena os lotes de vacinas.
+ * @param out O escritor de saída onde os lotes são impressos.
+ * @param date A data de referência, exclusiva.
+ */
+void listBatchesDatedBefore(BatchesHashTable *batchHashTable, Output *out, 
+	Date date) {
+	BatchIndex *index = &batchHashTable->batch_index;
+	BatchInfo *end = firstBatchDatedFrom(index, date), *batch_info;
+	for (batch_info = firstInBatchIndex(index); batch_info != end; 
+		batch_info = nextInBatchIndex(index, batch_info))
+		printBatch(batchHashTable, out, batch_info);
+}
+
+/**
+ * @brief Imprime todos os lotes de uma vacina, ordenados por data e ID.
+ * 
+ * @param batchHashTable A tabela de hash que armazena os lotes de vacinas.
+ * @param out O escritor de saída onde os lotes são impressos.
+ * @param vaccine A vacina cujos lotes são impressos.
+ * 
+ * @return 1 se a vacina tem pelo menos um lote, 0 caso contrário.
+ */
+int printBatchesOfVaccine(BatchesHashTable *batchHashTable, Output *out, 
+	Vaccine *vaccine) {
+	BatchInfo *batch_info;
+	for (batch_info = firstInBatchIndex(&vaccine->batches); batch_info; 
+		batch_info = nextInBatchIndex(&vaccine->batches, batch_info))
+		printBatch(batchHashTable, out, batch_info);
+	return firstInBatchIndex(&vaccine->batches) != NULL;
 }
 
 /**
  * @brief Lista os lotes presentes no sistema para os nomes de vacinas 
- * fornecidos.
+ * fornecidos, pela ordem dos nomes e, para cada vacina, por data e ID.
  * 
  * @param batchHashTable A tabela de hash que armazena os lotes de vacinas.
+ * @param out O escritor de saída onde os lotes e erros são impressos.
  * @param vaccineNames Lista dos nomes das vacinas a serem procuradas.
  * @param count Número total de vacinas na lista.
  * @param pt Um valor que indica se o programa deve imprimir as mensagens 
  * de erro em português ou não.
  */
 void listBatchesInSystemByGivenNames(BatchesHashTable *batchHashTable, 
-	char **vaccineNames, int count, int pt) {
-	Batches *current;
-	int i, j, found;
+	Output *out, char **vaccineNames, int count, int pt) {
+	Vaccine *vaccine;
+	int i, found;
 	for (i = 1; i < count; i++) {
-		found = 0;
-		for (j = 0; j < batchHashTable->size; j++) {
-			current = batchHashTable->batches[j];
-			while (current) {
-				if (strcmp(current->batch_info->vaccine_name, 
-					vaccineNames[i]) == 0) {
-					printBatch(current->batch_info);
-					found = 1;
-					break;
-				}
-				current = current->next;
-			}
-			if (found) break;
-		}
+		vaccine = searchVaccine(batchHashTable->vaccines, 
+			vaccineNames[i]);
+		found = vaccine != NULL && 
+			printBatchesOfVaccine(batchHashTable, out, vaccine);
 		if (!found) {
-			printErrorFormated(ENOSUCHVACCINE, ENOSUCHVACCINEPT, 
-				pt, vaccineNames[i]);
+			printErrorFormated(out, ENOSUCHVACCINE, 
+				ENOSUCHVACCINEPT, pt, vaccineNames[i]);
 		}
 	}
 }
 
+/**
+ * @brief Imprime os contadores das doses de uma vacina: doses disponíveis, 
+ * lotes utilizáveis, doses aplicadas e doses totais.
+ * 
+ * @param out O escritor de saída onde a linha é impressa.
+ * @param vaccine A vacina.
+ */
+void printVaccineStock(Output *out, Vaccine *vaccine) {
+	outputString(out, vaccine->name);
+	outputChar(out, ' ');
+	outputInt(out, vaccine->stock.available);
+	outputChar(out, ' ');
+	outputInt(out, vaccine->stock.batches);
+	outputChar(out, ' ');
+	outputInt(out, vaccine->stock.applications);
+	outputChar(out, ' ');
+	outputInt(out, vaccine->stock.doses);
+	outputChar(out, '\n');
+}
+
+/**
+ * @brief Lista os contadores das doses das vacinas fornecidas, pela ordem 
+ * dos nomes, ou de todas as vacinas do catálogo, pela ordem em que foram 
+ * registradas, se não houver nomes. Cada vacina custa tempo constante, 
+ * qualquer que seja o número de lotes. Tal como em `l`, uma vacina sem 
+ * lotes no sistema não existe.
+ * 
+ * @param batchHashTable A tabela de hash que armazena os lotes de vacinas.
+ * @param out O escritor de saída onde os contadores e erros são impressos.
+ * @param vaccineNames Lista dos nomes das vacinas, a começar no índice 1.
+ * @param count Número total de nomes na lista, incluindo o comando.
+ * @param pt Um valor que indica se o programa deve imprimir as mensagens 
+ * de erro em português ou não.
+ */
+void listStockInSystem(BatchesHashTable *batchHashTable, Output *out, 
+	char **vaccineNames, int count, int pt) {
+	VaccinesHashTable *vaccines = batchHashTable->vaccines;
+	Vaccine *vaccine;
+	int i;
+	if (count == 1)
+		for (i = 0; i < vaccines->vaccine_count; i++) {
+			vaccine = vaccineById(vaccines, i);
+			if (firstInBatchIndex(&vaccine->batches) != NULL)
+				printVaccineStock(out, vaccine);
+		}
+	for (i = 1; i < count; i++) {
+		vaccine = searchVaccine(vaccines, vaccineNames[i]);
+		if (vaccine != NULL && 
+			firstInBatchIndex(&vaccine->batches) != NULL)
+			printVaccineStock(out, vaccine);
+		else printErrorFormated(out, ENOSUCHVACCINE, 
+			ENOSUCHVACCINEPT, pt, vaccineNames[i]);
+	}
+}
+
 /**
  * @brief Retorna o lote válido mais antigo de uma vacina específica que 
  * ainda tenha doses disponíveis e não tenha expirado.
  * 
  * @param batchHashTable A tabela de hash que armazena os lotes de vacinas.
  * @param vaccine_name O nome da vacina para a qual o lote será procurado.
- * @param current_date A data atual utilizada para verificar a validade dos 
- * lotes.
  * 
  * @return O lote mais antigo válido para a vacina fornecida, ou NULL se não 
  * encontrar nenhum lote válido.
  */
 BatchInfo* oldestExistingValidBatchByVaccineName(
-BatchesHashTable* batchHashTable, char* vaccine_name, Date current_date) {
-	Batches *current;
-	BatchInfo *oldest_batch = NULL, *batch_info;
-	int i;
-	for (i = 0; i < batchHashTable->size; i++) {
-		current = batchHashTable->batches[i];
-		while (current) {
-			batch_info = current->batch_info;
-			if (strcmp(batch_info->vaccine_name, vaccine_name) 
-			== 0 && (batch_info->doses - batch_info->applications) 
-			> 0 && 
-			!expiredVaccineDate(current_date, batch_info->date)) {
-				if (oldest_batch == NULL || 
-					compareDate1Date2(batch_info->date, 
-					oldest_batch->date) < 0) {
-					oldest_batch = batch_info;
-				}
-			}
-			current = current->next;
-		}
+BatchesHashTable* batchHashTable, char* vaccine_name) {
+	Vaccine *vaccine;
+	vaccine = searchVaccine(batchHashTable->vaccines, vaccine_name);
+	if (vaccine == NULL) return NULL;
+	return oldestValidBatchOfVaccine(vaccine);
+}
+
+/**
+ * @brief Retira das heaps das vacinas todos os lotes que expiraram até à 
+ * data indicada, pela ordem da heap de validade, em tempo proporcional ao 
+ * número de lotes expirados. Os lotes continuam no sistema e nas listagens. 
+ * Os lotes que ficaram sem doses só saem da heap de validade aqui, para que 
+ * a aplicação de doses, que pode correr nas partições, não a altere.
+ * 
+ * @param batchHashTable A tabela de hash que armazena os lotes de vacinas.
+ * @param current_date A nova data atual do sistema.
+ */
+void expireBatches(BatchesHashTable *batchHashTable, Date current_date) {
+	BatchInfo *batch_info;
+	BatchHeap *expiry = &batchHashTable->expiry;
+	while ((batch_info = topOfBatchHeap(expiry)) != NULL && 
+		expiredVaccineDate(current_date, batch_info->date)) {
+		removeFromBatchHeap(expiry, batch_info);
+		removeBatchFromVaccine(vaccineOfBatch(batchHashTable, 
+			batch_info), batch_info);
 	}
-	return oldest_batch;
+}
+
+/**
+ * @brief Registra a aplicação de uma dose de um lote. Se o lote ficar sem 
+ * doses disponíveis, deixa de ser utilizável pela sua vacina.
+ * 
+ * @param batchHashTable A tabela de hash que armazena os lotes de vacinas.
+ * @param batch_info O lote de onde foi retirada a dose.
+ */
+void applyDoseFromBatch(BatchesHashTable *batchHashTable, 
+	BatchInfo *batch_info) {
+	Vaccine *vaccine = vaccineOfBatch(batchHashTable, batch_info);
+	batch_info->applications++;
+	vaccine->stock.applications++;
+	vaccine->stock.available--;
+	if (batch_info->doses - batch_info->applications <= 0)
+		removeBatchFromVaccine(vaccine, batch_info);
+}
+
+/**
+ * @brief Retira a disponibilidade de um lote que já teve aplicações, 
+ * deixando-o sem doses disponíveis: o total do lote passa a ser o das doses
+ * aplicadas, e só as doses por aplicar saem do total da vacina, que nunca 
+ * fica abaixo das suas aplicações.
+ * 
+ * @param batchHashTable A tabela de hash que armazena os lotes de vacinas.
+ * @param batch_info O lote a retirar.
+ */
+void withdrawBatchDoses(BatchesHashTable *batchHashTable, 
+	BatchInfo *batch_info) {
+	Vaccine *vaccine = vaccineOfBatch(batchHashTable, batch_info);
+	removeBatchFromVaccine(vaccine, batch_info);
+	vaccine->stock.doses -= batch_info->doses - batch_info->applications;
+	batch_info->doses = batch_info->applications;
 }
 
 /**
@@ -392,39 +578,73 @@ BatchesHashTable* batchHashTable, char* vaccine_name, Date current_date) {
  * @param batch_info As informações do lote a serem liberadas.
  */
 void freeBatchInfo(BatchInfo* batch_info) {
-	free(batch_info->batch);
-	free(batch_info->vaccine_name);
-	free(batch_info->date);
 	free(batch_info);
 }
 
 /**
- * @brief Remove um lote do sistema baseado no seu ID.
+ * @brief Libera um lote guardado na tabela de hash.
+ * 
+ * @param entry O lote (BatchInfo) a liberar.
+ */
+void freeBatchEntry(void *entry) {
+	freeBatchInfo((BatchInfo*)entry);
+}
+
+/**
+ * @brief Retira um lote dos índices ordenados, da heap da sua vacina e da 
+ * heap de validade.
+ * 
+ * @param batchHashTable A tabela de hash que armazena os lotes de vacinas.
+ * @param batch_info O lote a retirar.
+ */
+void unindexBatch(BatchesHashTable *batchHashTable, BatchInfo *batch_info) {
+	Vaccine *vaccine = vaccineOfBatch(batchHashTable, batch_info);
+	removeFromBatchIndex(&batchHashTable->batch_index, batch_info);
+	removeFromBatchIndex(&vaccine->batches, batch_info);
+	removeBatchFromVaccine(vaccine, batch_info);
+	removeFromBatchHeap(&batchHashTable->expiry, batch_info);
+	vaccine->stock.doses -= batch_info->doses;
+	vaccine->stock.applications -= batch_info->applications;
+}
+
+/**
+ * @brief Remove um lote do sistema baseado no seu ID. O lote só é liberado 
+ * quando nenhum relatório em curso o puder ver; o espaço para o guardar até
+ * lá é reservado antes de o tirar das tabelas.
  * 
  * @param batchHashTable A tabela de hash que armazena os lotes de vacinas.
  * @param batch_id O ID do lote a ser removido.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória, caso em que o lote 
+ * fica no sistema.
  */
-void removeBatchFromSystem(BatchesHashTable *batchHashTable, 
+int removeBatchFromSystem(BatchesHashTable *batchHashTable, 
 	const char *batch_id) {
-	unsigned int key;
-	Batches *current, *previous;
-	key = hash(batch_id, batchHashTable->size);
-	current = batchHashTable->batches[key];
-	previous = NULL;
-	while (current != NULL) {
-		if (strcmp(current->batch_id, batch_id) == 0) {
-			if (previous == NULL) 
-				batchHashTable->batches[key] = current->next;
-			else previous->next = current->next;
-			freeBatchInfo(current->batch_info);
-			free(current->batch_id);
-			free(current);
-			batchHashTable->batch_count--;
-			break;
-		}
-		previous = current;
-		current = current->next;
-	}
+	BatchInfo *batch_info;
+	if (!reserveRetired(&batchHashTable->retired, 1)) return 0;
+	batch_info = hashTableRemove(&batchHashTable->batches, batch_id);
+	if (batch_info == NULL) return 1;
+	unindexBatch(batchHashTable, batch_info);
+	return retireObject(&batchHashTable->retired, batch_info, 
+		freeBatchEntry);
+}
+
+/**
+ * @brief Retira um lote do uso: um lote sem aplicações é removido do 
+ * sistema e um lote com aplicações fica só sem doses, para que os registros 
+ * que o referem continuem válidos.
+ * 
+ * @param batchHashTable A tabela de hash que armazena os lotes de vacinas.
+ * @param batch_info O lote a retirar.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+int retireBatchFromSystem(BatchesHashTable *batchHashTable, 
+	BatchInfo *batch_info) {
+	if (batch_info->applications == 0)
+		return removeBatchFromSystem(batchHashTable, batch_info->batch);
+	withdrawBatchDoses(batchHashTable, batch_info);
+	return 1;
 }
 
 /**
@@ -433,19 +653,11 @@ void removeBatchFromSystem(BatchesHashTable *batchHashTable,
  * @param batchHashTable A tabela de hash que armazena os lotes de vacinas.
  */
 void destroyBatchesHashTable(BatchesHashTable *batchHashTable) {
-	int i;
-	Batches *current, *temp;
 	if (batchHashTable == NULL) return;
-	for (i = 0; i < batchHashTable->size; i++) {
-		current = batchHashTable->batches[i];
-		while (current) {
-			temp = current;
-			current = current->next;
-			freeBatchInfo(temp->batch_info);
-			free(temp->batch_id);
-			free(temp);
-		}
-	}
-	free(batchHashTable->batches);
+	destroyRetireList(&batchHashTable->retired);
+	hashTableForEach(&batchHashTable->batches, freeBatchEntry);
+	destroyVaccinesHashTable(batchHashTable->vaccines);
+	destroyBatchHeap(&batchHashTable->expiry);
+	destroyHashTable(&batchHashTable->batches);
 	free(batchHashTable);
 }
@@ -10,57 +10,125 @@
 #ifndef BATCH_H
 #define BATCH_H
 
+#include "constants.h"
 #include "date.h"
-
-/** Tamanho máximo permitido para a tabela de hash de lotes. */
-#define MAX_TABLE_SIZE 7993
-
-/**Estrutura que contém as informações de um lote de vacina. */
+#include "hashtable.h"
+#include "output.h"
+#include "vaccine.h"
+#include "batchindex.h"
+#include "batchheap.h"
+#include "epoch.h"
+
+/** Número de bytes do ID de um lote compactado, com meio byte por dígito. */
+#define BATCH_KEY_SIZE ((MAX_BATCH_NAME_SIZE + 1) / 2)
+
+/** ID de um lote compactado para comparações de tamanho fixo. A ordem das 
+ * chaves é a ordem alfabética dos IDs. */
+typedef struct BatchKey {
+    unsigned char digits[BATCH_KEY_SIZE]; /** Dígitos hexadecimais, dois 
+    por byte, completados com zeros. */
+    unsigned char length; /** Número de dígitos do ID. */
+} BatchKey;
+
+/**Estrutura que contém as informações de um lote de vacina, numa única 
+ * alocação com o ID e os ponteiros dos índices ordenados. */
 typedef struct BatchInfo {
-    char *batch; /** ID do lote. */
+    BatchKey key; /** ID do lote compactado. */
+    char batch[MAX_BATCH_NAME_SIZE + 1]; /** ID do lote. */
     Date date; /** Data de fabricação do lote. */
     int doses; /** Quantidade total de doses no lote. */
     int applications; /** Quantidade de doses aplicadas do lote. */
-    char *vaccine_name; /** Nome da vacina associada ao lote. */
+    int vaccine_id; /** ID da vacina associada ao lote no catálogo. */
+    int heap_index[BATCH_HEAP_LANES]; /** Posição do lote na heap da 
+    vacina e na heap de validade, ou -1 se o lote não estiver na heap. */
+    int level; /** Número de níveis do lote nos índices ordenados. */
+    struct BatchInfo *forward[]; /** Ponteiros para os lotes seguintes nos 
+    índices ordenados, `level` por cada pista. */
 } BatchInfo;
 
-/** Estrutura que representa um lote de vacina na tabela de hash. */
-typedef struct Batches {
-    char *batch_id; /** ID do lote. */
-    BatchInfo* batch_info; /** Informações do lote (BatchInfo). */
-    struct Batches *next; /**Ponteiro para o próximo lote na lista encadeada.*/
-} Batches;
-
 /** Estrutura que representa a tabela de hash para armazenar os lotes de 
  * vacinas. */
 typedef struct BatchesHashTable {
-    Batches **batches; /** Vetor de ponteiros para as listas de lotes. */
-    int batch_count; /** Número de lotes armazenados na tabela. */
-    int size; /** Tamanho atual da tabela de hash. */
+    HashTable batches; /** Tabela de hash dos lotes (BatchInfo), indexada 
+    pelo ID do lote. */
+    int max_batches; /** Número máximo de lotes no sistema, ou 0 para não 
+    haver limite. */
+    VaccinesHashTable *vaccines; /** Catálogo de vacinas, com os lotes 
+    utilizáveis de cada uma. */
+    BatchIndex batch_index; /** Índice de todos os lotes ordenados por data 
+    e ID. */
+    BatchHeap expiry; /** Lotes que entraram nas heaps das vacinas e ainda 
+    não expiraram, pela data de validade. */
+    RetireList retired; /** Lotes removidos que ainda podem estar a ser 
+    lidos por um relatório em curso. */
 } BatchesHashTable;
 
-BatchesHashTable* initBatchesHashTable();
+/** Estrutura que representa o estado de um lote num dado momento, para ser 
+ * impresso mais tarde noutra thread. */
+typedef struct BatchView {
+    const BatchInfo *batch; /** Lote, de onde só se lêem o ID e a data. */
+    const char *vaccine_name; /** Nome da vacina do lote. */
+    int available; /** Doses disponíveis nesse momento. */
+    int applications; /** Doses aplicadas nesse momento. */
+} BatchView;
+
+BatchesHashTable* initBatchesHashTable(int max_batches);
 
 int tooManyBatchesInSystem(BatchesHashTable *batchHashTable);
 
 int insertBatchInSystem(BatchesHashTable *hashTable, const char *batch_id, 
 Date date, int doses, const char *vaccine_name);
 
-Batches* searchBatchInSystem(BatchesHashTable *hashTable, const char *batch_id);
-int validBatchNumber(BatchesHashTable *batchHashTable, const char *batch_id, 
-int pt);
+int restoreBatchInSystem(BatchesHashTable *batchHashTable, 
+const char *batch_id, Date date, int doses, int applications, 
+const char *vaccine_name);
+
+BatchInfo* searchBatchInSystem(BatchesHashTable *hashTable, 
+const char *batch_id);
+int validBatchNumber(BatchesHashTable *batchHashTable, Output *out, 
+const char *batch_id, int pt);
+
+void packBatchKey(const char *batch_id, BatchKey *key);
+
+int compareBatchKeys(const BatchKey *key1, const BatchKey *key2);
+
+int compareBatches(BatchInfo *batch1, BatchInfo *batch2);
 
-int listAllBatchesInSystem(BatchesHashTable *batchHashTable);
+void viewBatch(BatchesHashTable *batchHashTable, BatchInfo *batch_info, 
+BatchView *view);
+
+void printBatchView(Output *out, const BatchView *view);
+
+size_t viewAllBatches(BatchesHashTable *batchHashTable, BatchView *views);
+
+void listAllBatchesInSystem(BatchesHashTable *batchHashTable, Output *out);
+
+void listBatchesDatedBefore(BatchesHashTable *batchHashTable, Output *out, 
+Date date);
 
 void listBatchesInSystemByGivenNames(BatchesHashTable *batchHashTable, 
-    char **vaccineNames, int count, int pt);
+    Output *out, char **vaccineNames, int count, int pt);
+
+void listStockInSystem(BatchesHashTable *batchHashTable, Output *out, 
+char **vaccineNames, int count, int pt);
 
 BatchInfo* oldestExistingValidBatchByVaccineName(
-BatchesHashTable* batchHashTable, char* vaccine_name, Date current_date);
+BatchesHashTable* batchHashTable, char* vaccine_name);
 
-void removeBatchFromSystem(BatchesHashTable *batchHashTable, 
+void expireBatches(BatchesHashTable *batchHashTable, Date current_date);
+
+void applyDoseFromBatch(BatchesHashTable *batchHashTable, 
+BatchInfo *batch_info);
+
+void withdrawBatchDoses(BatchesHashTable *batchHashTable, 
+BatchInfo *batch_info);
+
+int removeBatchFromSystem(BatchesHashTable *batchHashTable, 
 const char *batch_id);
 
+int retireBatchFromSystem(BatchesHashTable *batchHashTable, 
+BatchInfo *batch_info);
+
 void destroyBatchesHashTable(BatchesHashTable *hashTable);
 
 #endif
@@ -0,0 +1,137 @@
+/**
+ * @file batchheap.c
+ * @author Diogo Lobo (ist1109293)
+ * @brief Implementação das heaps mínimas de lotes, ordenadas por data de 
+ * validade e ID do lote.
+ * @date 2026-10-16
+ */
+
+#include <stdlib.h>
+#include "batchheap.h"
+#include "batch.h"
+
+/**
+ * @brief Inicializa uma heap de lotes vazia.
+ * 
+ * @param heap A heap a inicializar.
+ * @param lane A pista das posições guardadas nos lotes usada pela heap.
+ */
+void initBatchHeap(BatchHeap *heap, int lane) {
+	heap->items = NULL;
+	heap->count = heap->capacity = 0;
+	heap->lane = lane;
+}
+
+/**
+ * @brief Coloca um lote numa posição da heap, atualizando o seu índice.
+ * 
+ * @param heap A heap.
+ * @param i A posição da heap.
+ * @param batch_info O lote a colocar.
+ */
+void placeInHeap(BatchHeap *heap, int i, struct BatchInfo *batch_info) {
+	heap->items[i] = batch_info;
+	batch_info->heap_index[heap->lane] = i;
+}
+
+/**
+ * @brief Sobe um lote na heap até repor a propriedade de heap mínima.
+ * 
+ * @param heap A heap.
+ * @param i A posição inicial do lote.
+ */
+void siftUp(BatchHeap *heap, int i) {
+	BatchInfo *batch_info = heap->items[i];
+	while (i > 0 && 
+		compareBatches(batch_info, heap->items[(i - 1) / 2]) < 0) {
+		placeInHeap(heap, i, heap->items[(i - 1) / 2]);
+		i = (i - 1) / 2;
+	}
+	placeInHeap(heap, i, batch_info);
+}
+
+/**
+ * @brief Desce um lote na heap até repor a propriedade de heap mínima.
+ * 
+ * @param heap A heap.
+ * @param i A posição inicial do lote.
+ */
+void siftDown(BatchHeap *heap, int i) {
+	BatchInfo *batch_info = heap->items[i];
+	int child;
+	while ((child = 2 * i + 1) < heap->count) {
+		if (child + 1 < heap->count && 
+			compareBatches(heap->items[child + 1], 
+				heap->items[child]) < 0) child++;
+		if (compareBatches(heap->items[child], batch_info) >= 0)
+			break;
+		placeInHeap(heap, i, heap->items[child]);
+		i = child;
+	}
+	placeInHeap(heap, i, batch_info);
+}
+
+/**
+ * @brief Insere um lote na heap.
+ * 
+ * @param heap A heap.
+ * @param batch_info O lote a inserir.
+ * 
+ * @return 1 se o lote foi inserido, 0 em caso de erro de memória.
+ */
+int pushToBatchHeap(BatchHeap *heap, struct BatchInfo *batch_info) {
+	BatchInfo **new_items;
+	int new_capacity;
+	if (heap->count == heap->capacity) {
+		new_capacity = heap->capacity ? 
+			heap->capacity * 2 : INITIAL_HEAP_CAPACITY;
+		new_items = (BatchInfo **)realloc(heap->items, 
+			new_capacity * sizeof(BatchInfo *));
+		if (!new_items) return 0;
+		heap->items = new_items;
+		heap->capacity = new_capacity;
+	}
+	heap->items[heap->count++] = batch_info;
+	siftUp(heap, heap->count - 1);
+	return 1;
+}
+
+/**
+ * @brief Retira um lote da heap. Não faz nada se o lote já não estiver na 
+ * heap.
+ * 
+ * @param heap A heap.
+ * @param batch_info O lote a retirar.
+ */
+void removeFromBatchHeap(BatchHeap *heap, struct BatchInfo *batch_info) {
+	BatchInfo *last;
+	int i = batch_info->heap_index[heap->lane];
+	if (i < 0) return;
+	batch_info->heap_index[heap->lane] = -1;
+	last = heap->items[--heap->count];
+	if (i == heap->count) return;
+	placeInHeap(heap, i, last);
+	siftUp(heap, i);
+	if (heap->items[i] == last) siftDown(heap, i);
+}
+
+/**
+ * @brief Devolve o lote com a data de validade e o ID menores da heap.
+ * 
+ * @param heap A heap.
+ * 
+ * @return O lote, ou NULL se a heap estiver vazia.
+ */
+struct BatchInfo* topOfBatchHeap(BatchHeap *heap) {
+	return heap->count > 0 ? heap->items[0] : NULL;
+}
+
+/**
+ * @brief Libera a memória de uma heap. Os lotes não são liberados.
+ * 
+ * @param heap A heap.
+ */
+void destroyBatchHeap(BatchHeap *heap) {
+	free(heap->items);
+	initBatchHeap(heap, heap->lane);
+}
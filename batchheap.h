@@ -0,0 +1,45 @@
+/**
+ * @file batchheap.h
+ * @author Diogo Lobo (ist1109293)
+ * @brief Cabeçalho das heaps mínimas de lotes, ordenadas por data de 
+ * validade e ID do lote. A posição de cada lote na heap está guardada no 
+ * próprio lote, uma por pista, pelo que um lote pode estar ao mesmo tempo 
+ * na heap da sua vacina e na heap de validade do sistema, e ser retirado de 
+ * qualquer uma em tempo logarítmico.
+ * @date 2026-10-16
+ */
+
+#ifndef BATCHHEAP_H
+#define BATCHHEAP_H
+
+/** Pista da heap dos lotes utilizáveis de uma vacina. */
+#define BATCH_HEAP_VACCINE_LANE 0
+/** Pista da heap de validade de todos os lotes utilizáveis do sistema. */
+#define BATCH_HEAP_EXPIRY_LANE 1
+/** Número de pistas com posições guardadas em cada lote. */
+#define BATCH_HEAP_LANES 2
+
+/** Capacidade inicial de uma heap de lotes. */
+#define INITIAL_HEAP_CAPACITY 4
+
+struct BatchInfo;
+
+/** Estrutura que representa uma heap mínima de lotes. */
+typedef struct BatchHeap {
+    struct BatchInfo **items; /** Lotes da heap. */
+    int count; /** Número de lotes presentes na heap. */
+    int capacity; /** Capacidade alocada para a heap. */
+    int lane; /** Pista das posições utilizadas por esta heap. */
+} BatchHeap;
+
+void initBatchHeap(BatchHeap *heap, int lane);
+
+int pushToBatchHeap(BatchHeap *heap, struct BatchInfo *batch_info);
+
+void removeFromBatchHeap(BatchHeap *heap, struct BatchInfo *batch_info);
+
+struct BatchInfo* topOfBatchHeap(BatchHeap *heap);
+
+void destroyBatchHeap(BatchHeap *heap);
+
+#endif
@@ -0,0 +1,174 @@
+/**
+ * @file batchindex.c
+ * @author Diogo Lobo (ist1109293)
+ * @brief Implementação do índice ordenado de lotes (skip list ordenada por
+ * data de validade e ID do lote), com inserção, remoção e pesquisa em tempo
+ * logarítmico esperado e percurso ordenado sem alocações.
+ * @date 2026-10-16
+ */
+
+#include <stdlib.h>
+#include "batchindex.h"
+#include "batch.h"
+#include "date.h"
+
+/** Semente inicial do gerador de níveis aleatórios. */
+#define BATCH_INDEX_SEED 2463534242u
+
+/**
+ * @brief Inicializa um índice de lotes vazio.
+ *
+ * @param index O índice a inicializar.
+ * @param lane A pista dos ponteiros embutidos nos lotes usada pelo índice.
+ */
+void initBatchIndex(BatchIndex *index, int lane) {
+	int i;
+	for (i = 0; i < BATCH_INDEX_MAX_LEVEL; i++) index->head[i] = NULL;
+	index->level = 1;
+	index->lane = lane;
+	index->seed = BATCH_INDEX_SEED;
+}
+
+/**
+ * @brief Sorteia o número de níveis de um novo lote, com distribuição
+ * geométrica de razão 1/4.
+ *
+ * @param index O índice cujo gerador é utilizado.
+ *
+ * @return O número de níveis, entre 1 e BATCH_INDEX_MAX_LEVEL.
+ */
+int randomBatchIndexLevel(BatchIndex *index) {
+	unsigned int r;
+	int level = 1;
+	index->seed ^= index->seed << 13;
+	index->seed ^= index->seed >> 17;
+	index->seed ^= index->seed << 5;
+	r = index->seed;
+	while ((r & 3) == 0 && level < BATCH_INDEX_MAX_LEVEL) {
+		level++;
+		r >>= 2;
+	}
+	return level;
+}
+
+/**
+ * @brief Devolve o endereço do ponteiro para o lote seguinte, num dado
+ * nível, a partir de um lote do índice ou da cabeça do índice.
+ *
+ * @param index O índice.
+ * @param batch_info O lote, ou NULL para a cabeça do índice.
+ * @param level O nível pretendido.
+ *
+ * @return O endereço do ponteiro para o lote seguinte.
+ */
+struct BatchInfo** nextSlot(BatchIndex *index, struct BatchInfo *batch_info,
+	int level) {
+	if (batch_info == NULL) return &index->head[level];
+	return &batch_info->forward[index->lane * batch_info->level + level];
+}
+
+/**
+ * @brief Encontra, em cada nível, o último lote anterior ao lote indicado.
+ *
+ * @param index O índice.
+ * @param batch_info O lote de referência.
+ * @param update Vetor onde são guardados os antecessores de cada nível
+ * (NULL representa a cabeça do índice).
+ */
+void findPredecessors(BatchIndex *index, struct BatchInfo *batch_info,
+	struct BatchInfo **update) {
+	struct BatchInfo *current = NULL, *next;
+	int i;
+	for (i = index->level - 1; i >= 0; i--) {
+		while ((next = *nextSlot(index, current, i)) != NULL &&
+			compareBatches(next, batch_info) < 0) current = next;
+		update[i] = current;
+	}
+}
+
+/**
+ * @brief Insere um lote no índice. O número de níveis do lote já deve ter
+ * sido definido com randomBatchIndexLevel.
+ *
+ * @param index O índice.
+ * @param batch_info O lote a inserir.
+ */
+void insertInBatchIndex(BatchIndex *index, struct BatchInfo *batch_info) {
+	struct BatchInfo *update[BATCH_INDEX_MAX_LEVEL];
+	struct BatchInfo **slot;
+	int i;
+	findPredecessors(index, batch_info, update);
+	for (i = index->level; i < batch_info->level; i++) update[i] = NULL;
+	if (batch_info->level > index->level) index->level = batch_info->level;
+	for (i = 0; i < batch_info->level; i++) {
+		slot = nextSlot(index, update[i], i);
+		*nextSlot(index, batch_info, i) = *slot;
+		*slot = batch_info;
+	}
+}
+
+/**
+ * @brief Remove um lote do índice.
+ *
+ * @param index O índice.
+ * @param batch_info O lote a remover.
+ */
+void removeFromBatchIndex(BatchIndex *index, struct BatchInfo *batch_info) {
+	struct BatchInfo *update[BATCH_INDEX_MAX_LEVEL];
+	struct BatchInfo **slot;
+	int i;
+	findPredecessors(index, batch_info, update);
+	for (i = 0; i < batch_info->level && i < index->level; i++) {
+		slot = nextSlot(index, update[i], i);
+		if (*slot == batch_info)
+			*slot = *nextSlot(index, batch_info, i);
+	}
+	while (index->level > 1 && index->head[index->level - 1] == NULL)
+		index->level--;
+}
+
+/**
+ * @brief Devolve o primeiro lote do índice.
+ *
+ * @param index O índice.
+ *
+ * @return O lote com a data de validade (e ID) mais antiga, ou NULL se o
+ * índice estiver vazio.
+ */
+struct BatchInfo* firstInBatchIndex(BatchIndex *index) {
+	return index->head[0];
+}
+
+/**
+ * @brief Devolve o lote seguinte a um lote do índice.
+ *
+ * @param index O índice.
+ * @param batch_info O lote atual.
+ *
+ * @return O lote seguinte, ou NULL se for o último.
+ */
+struct BatchInfo* nextInBatchIndex(BatchIndex *index,
+	struct BatchInfo *batch_info) {
+	return *nextSlot(index, batch_info, 0);
+}
+
+/**
+ * @brief Devolve o primeiro lote com data de validade igual ou posterior à
+ * data indicada, descendo a skip list em tempo logarítmico. Os lotes
+ * anteriores a esse são exatamente os lotes com validade anterior à data.
+ *
+ * @param index O índice.
+ * @param date A data de referência.
+ *
+ * @return O primeiro lote com validade não anterior a date, ou NULL se não
+ * existir.
+ */
+struct BatchInfo* firstBatchDatedFrom(BatchIndex *index, Date date) {
+	struct BatchInfo *current = NULL, *next;
+	int i;
+	for (i = index->level - 1; i >= 0; i--) {
+		while ((next = *nextSlot(index, current, i)) != NULL &&
+			compareDate1Date2(next->date, date) < 0) current = next;
+	}
+	return *nextSlot(index, current, 0);
+}
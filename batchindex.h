@@ -0,0 +1,54 @@
+/**
+ * @file batchindex.h
+ * @author Diogo Lobo (ist1109293)
+ * @brief Cabeçalho do índice ordenado de lotes. O índice é uma skip list
+ * ordenada por data de validade e ID do lote, mantida a cada inserção e
+ * remoção, que permite listar os lotes por ordem sem os voltar a ordenar e
+ * responder a pesquisas por intervalo de datas.
+ * @date 2026-10-16
+ */
+
+#ifndef BATCHINDEX_H
+#define BATCHINDEX_H
+
+#include "date.h"
+
+/** Número máximo de níveis da skip list. */
+#define BATCH_INDEX_MAX_LEVEL 16
+
+/** Pista do índice global de todos os lotes do sistema. */
+#define BATCH_INDEX_ALL_LANE 0
+/** Pista do índice dos lotes de uma única vacina. */
+#define BATCH_INDEX_VACCINE_LANE 1
+/** Número de pistas com ponteiros embutidos em cada lote. */
+#define BATCH_INDEX_LANES 2
+
+struct BatchInfo;
+
+/** Estrutura que representa uma skip list de lotes. Os ponteiros para os
+ * lotes seguintes estão embutidos nos próprios lotes, um conjunto por pista,
+ * pelo que um lote pode estar ao mesmo tempo em índices de pistas distintas. */
+typedef struct BatchIndex {
+    struct BatchInfo *head[BATCH_INDEX_MAX_LEVEL]; /** Primeiro lote de cada
+    nível. */
+    int level; /** Número de níveis atualmente em uso. */
+    int lane; /** Pista dos ponteiros utilizados por este índice. */
+    unsigned int seed; /** Estado do gerador de níveis aleatórios. */
+} BatchIndex;
+
+void initBatchIndex(BatchIndex *index, int lane);
+
+int randomBatchIndexLevel(BatchIndex *index);
+
+void insertInBatchIndex(BatchIndex *index, struct BatchInfo *batch_info);
+
+void removeFromBatchIndex(BatchIndex *index, struct BatchInfo *batch_info);
+
+struct BatchInfo* firstInBatchIndex(BatchIndex *index);
+
+struct BatchInfo* nextInBatchIndex(BatchIndex *index,
+struct BatchInfo *batch_info);
+
+struct BatchInfo* firstBatchDatedFrom(BatchIndex *index, Date date);
+
+#endif
@@ -0,0 +1,729 @@
+/**
+ * @file commands.c
+ * @author Diogo Lobo (ist1109293)
+ * @brief Implementação dos comandos do sistema de vacinação. Cada linha é 
+ * primeiro preparada, sem tocar no estado do sistema, e depois aplicada.
+ * @date 2026-10-16
+ */
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "constants.h"
+#include "utils.h"
+#include "date.h"
+#include "batch.h"
+#include "snapshot.h"
+#include "shard.h"
+#include "report.h"
+#include "commands.h"
+
+/**
+ * @brief Finaliza o programa, liberando recursos alocados e destruindo o 
+ * sistema de vacinação.
+ * 
+ * @param vaccinationSystem Sistema de vacinação que será destruído.
+ * @param error Código de erro que será retornado ao sistema operacional 
+ * ao final da execução.
+ */
+void endProgram(VaccinationSystem* vaccinationSystem, int error) {
+	destroyVaccinationSystem(vaccinationSystem);
+	exit(error);
+}
+
+/**
+ * @brief Finaliza o programa em caso de erro de memória, liberando recursos e 
+ * exibindo uma mensagem de erro.
+ * 
+ * @param vaccinationSystem Sistema de vacinação que será destruído.
+ * @param pt Indicador de idioma (1 para português, 0 para outro idioma).
+ */
+void endProgramMemError(VaccinationSystem* vaccinationSystem, int pt) {
+	printError(&vaccinationSystem->output, ENOMEMORY, ENOMEMORYPT, pt);
+	endProgram(vaccinationSystem, 1);
+}
+
+/**
+ * @brief Finaliza o programa se uma mutação não tiver sido acrescentada ao 
+ * diário, porque deixaria de poder ser recuperada.
+ * 
+ * @param vaccinationSystem O sistema de vacinação.
+ * @param result O resultado da escrita no diário, 0 em caso de falha.
+ * @param pt Indicador de linguagem para exibição de mensagens de erro no 
+ * idioma correto.
+ */
+void checkJournal(VaccinationSystem* vaccinationSystem, int result, int pt) {
+	if (result) return;
+	fprintf(stderr, "%s\n", !pt ? EJOURNALWRITE : EJOURNALWRITEPT);
+	endProgram(vaccinationSystem, 1);
+}
+
+/**
+ * @brief Reserva memória temporária para o comando atual na arena de 
+ * rascunho do sistema. A memória é liberada automaticamente antes da leitura
+ * do comando seguinte.
+ * 
+ * @param vaccinationSystem Sistema de vacinação que contém a arena.
+ * @param size Número de bytes pretendido.
+ * @param pt Indicador de idioma (1 para português, 0 para outro idioma).
+ * 
+ * @return Ponteiro para a memória reservada. Em caso de falta de memória o 
+ * programa é finalizado.
+ */
+void* scratchAlloc(VaccinationSystem* vaccinationSystem, size_t size, 
+	int pt) {
+	void *memory = arenaAlloc(&vaccinationSystem->scratch, size);
+	if (memory == NULL) endProgramMemError(vaccinationSystem, pt);
+	return memory;
+}
+
+/**
+ * @brief Devolve o texto de um argumento do comando, ou uma string vazia se
+ * o comando tiver menos argumentos.
+ * 
+ * @param tokens Os argumentos do comando, começando pelo próprio comando.
+ * @param count O número de argumentos.
+ * @param i A posição do argumento pretendido.
+ * 
+ * @return O texto do argumento.
+ */
+char* tokenText(Token* tokens, int count, int i) {
+	return i < count ? tokens[i].text : "";
+}
+
+/**
+ * @brief Valida os dados de entrada para a criação de um novo lote de vacina.
+ * As verificações de formato do lote e do nome já foram feitas ao preparar o
+ * comando; aqui só se imprimem os seus erros, pela ordem original, 
+ * intercalados com as verificações que dependem do estado do sistema.
+ * 
+ * @param vs Sistema de vacinação que contém os lotes 
+ * e outras informações do sistema.
+ * @param command O comando `c` preparado.
+ * @param pt Indicador de linguagem.
+ * 
+ * @return Retorna 1 se todos os parâmetros forem válidos e 0 se algum deles 
+ * for inválido.
+ */
+int validcreateBatchInput(VaccinationSystem* vs, Command* command, int pt) {
+	if (!command->valid_batch) {
+		printError(&vs->output, EINVALIDBATCH, EINVALIDBATCHPT, pt);
+		return 0;
+	}
+	if (!validBatchNumber(vs->batches_ht, &vs->output, 
+		command->tokens[1].text, pt)) return 0;
+	if (!command->valid_name) {
+		printError(&vs->output, EINVALIDNAME, EINVALIDNAMEPT, pt);
+		return 0;
+	}
+	return validDate(&vs->output, vs->current_date, command->date, pt) && 
+		validDosesNumber(&vs->output, command->doses, pt);
+}
+
+/**
+ * @brief Faz o parsing dos argumentos para criar um novo lote de vacina. O 
+ * número de campos lidos segue a ordem lote, dia, mês, ano, doses e nome, e 
+ * a leitura para no primeiro campo mal formado. Não depende do estado do 
+ * sistema, pelo que pode ser feito em paralelo para linhas distintas.
+ * 
+ * @param command O comando `c` a preencher com os argumentos, a data, as 
+ * doses e o resultado da validação do lote e do nome.
+ */
+void prepareCreateBatch(Command* command) {
+	Token *tokens = command->tokens;
+	int num_args = scanCreateBatch(command->input, command->length, 
+		tokens, &command->date, &command->doses);
+	command->count = CREATE_BATCH_TOKENS;
+	command->valid_batch = validBatch(tokens[1].text, num_args);
+	command->valid_name = validName(tokens[4].text, num_args);
+}
+
+/**
+ * @brief Acerta o nome da vacina do comando `a`, o último argumento, que é
+ * o resto da linha. Se o nome do usuário estiver entre aspas, a vacina é só
+ * a palavra seguinte; em ambos os casos é limitada a MAX_VACCINE_NAME_SIZE
+ * caracteres, como "%50s" e "%50[^\n]".
+ * 
+ * @param command O comando `a` já dividido em argumentos.
+ */
+void prepareApplyVaccine(Command* command) {
+	Token *vaccine = &command->tokens[2];
+	size_t i;
+	if (command->count < 3) return;
+	if (command->tokens[1].text[-1] == '"') {
+		for (i = 0; i < vaccine->length && 
+			!isspace((unsigned char)vaccine->text[i]); i++);
+		vaccine->length = i;
+	}
+	if (vaccine->length > MAX_VACCINE_NAME_SIZE)
+		vaccine->length = MAX_VACCINE_NAME_SIZE;
+	vaccine->text[vaccine->length] = '\0';
+}
+
+/**
+ * @brief Cria um novo lote de vacina no sistema a partir da entrada fornecida.
+ * @param vaccinationSystem Sistema de vacinação utilizado para 
+ * inserir o novo lote de vacina.
+ * @param command O comando `c` preparado.
+ * @param pt Indicador de linguagem para exibição de mensagens de erro no 
+ * idioma correto.
+ */
+void createBatchInput(VaccinationSystem* vaccinationSystem, Command* command, 
+	int pt) {
+	Token *tokens = command->tokens;
+	if (tooManyBatchesInSystem(vaccinationSystem->batches_ht)) {
+		printError(&vaccinationSystem->output, ETOOMANYVACCINES, 
+			ETOOMANYVACCINESPT, pt);
+		return;
+	}
+	if (!validcreateBatchInput(vaccinationSystem, command, pt)) return;
+	if (!insertBatchInSystem(vaccinationSystem->batches_ht, tokens[1].text, 
+		command->date, command->doses, tokens[4].text))
+		endProgramMemError(vaccinationSystem, pt);
+	checkJournal(vaccinationSystem, journalCreateBatch(
+		&vaccinationSystem->journal, tokens[1].text, command->date, 
+		command->doses, tokens[4].text), pt);
+	outputBytes(&vaccinationSystem->output, tokens[1].text, 
+		tokens[1].length);
+	outputChar(&vaccinationSystem->output, '\n');
+}
+
+/**
+ * @brief Processa a entrada do usuário para listar lotes de vacinas. A 
+ * listagem de todos os lotes, se for longa, é feita noutra thread.
+ * @param vaccinationSystem Sistema de vacinação utilizado para 
+ * acessar os lotes de vacinas no sistema e realizar operações relacionadas.
+ * @param tokens Argumentos do comando, com os nomes das vacinas ou apenas o
+ * comando para listar todos os lotes.
+ * @param count Número de argumentos, incluindo o comando.
+ * @param pt Indicador de linguagem para exibição de mensagens de erro no 
+ * idioma correto.
+ */
+void listBatchInput(VaccinationSystem* vaccinationSystem, Token* tokens, 
+	int count, int pt) {
+	char** vaccinesNames;
+	int i;
+	if (count == 1) {
+		if (!reportAllBatches(vaccinationSystem))
+			listAllBatchesInSystem(vaccinationSystem->batches_ht, 
+				&vaccinationSystem->output);
+		return;
+	}
+	vaccinesNames = scratchAlloc(vaccinationSystem, sizeof(char*) * count, 
+		pt);
+	for (i = 0; i < count; i++) vaccinesNames[i] = tokens[i].text;
+	listBatchesInSystemByGivenNames(vaccinationSystem->batches_ht, 
+		&vaccinationSystem->output, vaccinesNames, count, pt);
+}
+
+/**
+ * @brief Processa a entrada do comando que lista, pela ordem de `l`, os 
+ * lotes com validade anterior a uma data, que pode ser anterior à data 
+ * atual.
+ * @param vaccinationSystem O sistema de vacinação.
+ * @param tokens Argumentos do comando, com a data de referência.
+ * @param count Número de argumentos, incluindo o comando.
+ * @param pt Indicador de linguagem para exibição de mensagens de erro no 
+ * idioma correto.
+ */
+void listBatchesBeforeInput(VaccinationSystem* vaccinationSystem, 
+	Token* tokens, int count, int pt) {
+	Date date = createDate(0, 0, 0);
+	if (count < 2 || !tokenDate(&tokens[1], &date) || 
+		!validCalendarDate(date)) {
+		printError(&vaccinationSystem->output, EINVALIDDATE, 
+			EINVALIDDATEPT, pt);
+		return;
+	}
+	listBatchesDatedBefore(vaccinationSystem->batches_ht, 
+		&vaccinationSystem->output, date);
+}
+
+/**
+ * @brief Processa a entrada do comando para aplicar uma vacina a um paciente.
+ * @param vaccinationSystem O sistema de vacinação, utilizado para acessar os
+ *  dados dos registros e do lote de vacinas.
+ * @param tokens Argumentos do comando, com o nome do paciente e o nome da 
+ * vacina a ser aplicada.
+ * @param count Número de argumentos, incluindo o comando.
+ * @param pt Indicador de linguagem para exibição de mensagens de erro no 
+ * idioma correto.
+ */
+void applyVaccineInput(VaccinationSystem* vaccinationSystem, Token* tokens, 
+	int count, int pt) {
+	int result;
+	BatchInfo* batch_info;
+	batch_info = oldestExistingValidBatchByVaccineName(
+		vaccinationSystem->batches_ht, tokenText(tokens, count, 2));
+	if (batch_info == NULL) {
+		printError(&vaccinationSystem->output, ENOSTOCK, ENOSTOCKPT, 
+			pt);
+		return;
+	}
+	result = insertUserRecord(vaccinationSystem, tokens[1].text, 
+		batch_info, vaccinationSystem->current_date);
+	if (result == 0) endProgramMemError(vaccinationSystem, pt);
+	else if (result == 2)
+		printError(&vaccinationSystem->output, EALREADYVACCINATED, 
+			EALREADYVACCINATEDPT, pt);
+	else {
+		applyDoseFromBatch(vaccinationSystem->batches_ht, batch_info);
+		checkJournal(vaccinationSystem, journalApplyDose(
+			&vaccinationSystem->journal, tokens[1].text, 
+			batch_info->batch), pt);
+		outputString(&vaccinationSystem->output, batch_info->batch);
+		outputChar(&vaccinationSystem->output, '\n');
+	}
+}
+
+/**
+ * @brief Devolve o ID de lote de um argumento, limitado a 
+ * MAX_BATCH_NAME_SIZE caracteres.
+ * 
+ * @param tokens Os argumentos do comando.
+ * @param count O número de argumentos.
+ * @param i A posição do argumento com o ID do lote.
+ * 
+ * @return O ID do lote.
+ */
+char* batchIdToken(Token* tokens, int count, int i) {
+	if (i < count && tokens[i].length > MAX_BATCH_NAME_SIZE) {
+		tokens[i].text[MAX_BATCH_NAME_SIZE] = '\0';
+		tokens[i].length = MAX_BATCH_NAME_SIZE;
+	}
+	return tokenText(tokens, count, i);
+}
+
+/**
+ * @brief Processa a entrada do comando para remover um lote de vacinas.
+ * @param vaccinationSystem O sistema de vacinação, utilizado para acessar 
+ * os dados dos lotes de vacinas.
+ * @param tokens Argumentos do comando, com o identificador do lote a ser 
+ * removido.
+ * @param count Número de argumentos, incluindo o comando.
+ * @param pt Indicador de linguagem para exibição de mensagens de erro no 
+ * idioma correto.
+ */
+void removeBatchInput(VaccinationSystem* vaccinationSystem, Token* tokens, 
+	int count, int pt) {
+	char *batch_id = batchIdToken(tokens, count, 1);
+	BatchInfo* batch;
+	batch = searchBatchInSystem(vaccinationSystem->batches_ht, batch_id);
+	if (batch == NULL) {
+		printErrorFormated(&vaccinationSystem->output,
+			ENOSUCHBATCH, ENOSUCHBATCHPT, pt, batch_id);
+		return;
+	}
+	checkJournal(vaccinationSystem, journalRemoveBatch(
+		&vaccinationSystem->journal, batch_id), pt);
+	outputInt(&vaccinationSystem->output, batch->applications);
+	outputChar(&vaccinationSystem->output, '\n');
+	if (!retireBatchFromSystem(vaccinationSystem->batches_ht, batch))
+		endProgramMemError(vaccinationSystem, pt);
+}
+
+/**
+ * @brief Imprime o número de registros apagados por um comando `d`.
+ * 
+ * @param vaccinationSystem O sistema de vacinação, cujo escritor de saída é
+ * utilizado.
+ * @param count O número de registros apagados.
+ */
+void printCount(VaccinationSystem* vaccinationSystem, int count) {
+	outputInt(&vaccinationSystem->output, count);
+	outputChar(&vaccinationSystem->output, '\n');
+}
+
+/**
+ * @brief Processa a exclusão de um registro de vacinação para um usuário 
+ * específico.
+ * 
+ * @param vaccinationSystem O sistema de vacinação, 
+ * usado para acessar e modificar os registros de vacinação.
+ * @param pt Indicador de linguagem para exibição de mensagens de erro no 
+ * idioma correto.
+ * @param name O nome do usuário que será excluído do sistema.
+ * 
+ * @return Retorna -1 se o usuário não existir no sistema, 
+ * ou o valor retornado pela função `deleteRecordVaccinationRecordsUser` 
+ * caso contrário (geralmente um código de sucesso ou erro).
+ */
+int deleteRecordInput1Arg(VaccinationSystem* vaccinationSystem, int pt, 
+	char* name) {
+	VaccinationRecordsHashtable *records = userRecords(vaccinationSystem, 
+		name);
+	if (!userExistInSystem(records, name)) {
+		printErrorFormated(&vaccinationSystem->output,
+			ENOSUCHUSER, ENOSUCHUSERPT, pt, name);
+		return -1;
+	}
+	return deleteRecordVaccinationRecordsUser(records, name);
+}
+
+/**
+ * @brief Processa a exclusão de um registro de vacinação para um usuário 
+ * e uma data específicos.
+ * @param vaccinationSystem O sistema de vacinação, utilizado para acessar 
+ * e modificar os registros de vacinação.
+ * @param pt Indicador de linguagem para exibição de mensagens de erro no 
+ * idioma correto.
+ * @param name O nome do usuário que terá o registro de vacinação excluído.
+ * @param date A data da vacinação a excluir.
+ * 
+ * @return Retorna -1 em caso de erro, como o usuário não existente 
+ * ou a data inválida, ou o valor retornado pela função 
+ * `deleteRecordByNameAndDate` em caso de sucesso 
+ * (geralmente o número de registros deletados).
+ */
+int deleteRecordInput2Args(VaccinationSystem* vaccinationSystem, int pt, 
+	char* name, Date date) {
+	VaccinationRecordsHashtable *records = userRecords(vaccinationSystem, 
+		name);
+	if (!userExistInSystem(records, name)) {
+		printErrorFormated(&vaccinationSystem->output,
+			ENOSUCHUSER, ENOSUCHUSERPT, pt, name);
+		return -1;
+	}
+	if (!validDate(&vaccinationSystem->output, date, 
+		vaccinationSystem->current_date, pt)) return -1;
+	return deleteRecordByNameAndDate(records, name, date);
+}
+
+/**
+ * @brief Valida a entrada para a exclusão de um registro de vacinação com
+ * três argumentos: nome do usuário, nome do lote e data de vacinação.
+ * @param vaccinationSystem O sistema de vacinação, utilizado para acessar
+ * os registros de vacinação e lotes.
+ * @param name O nome do usuário cujo registro de vacinação será deletado.
+ * @param batch_name O nome do lote de vacina associado ao registro de
+ * vacinação.
+ * @param date A data de vacinação que será verificada.
+ * @param pt Indicador de linguagem para exibição de mensagens de erro no
+ * idioma correto.
+ * 
+ * @return Retorna 1 se as validações forem bem-sucedidas, ou -1 se qualquer
+ * validação falhar.
+ */
+int validDeleteRecordInput3Args(VaccinationSystem* vaccinationSystem, 
+	char* name, char* batch_name, Date date, int pt) {
+	if (!userExistInSystem(userRecords(vaccinationSystem, name), name)) {
+		printErrorFormated(&vaccinationSystem->output,
+			ENOSUCHUSER, ENOSUCHUSERPT, pt, name);
+		return -1;
+	}
+	if (!validDate(&vaccinationSystem->output, date, 
+		vaccinationSystem->current_date, pt)) return -1;
+	if (searchBatchInSystem(vaccinationSystem->batches_ht, 
+		batch_name)== NULL) {
+		printErrorFormated(&vaccinationSystem->output,
+			ENOSUCHBATCH, ENOSUCHBATCHPT, pt, batch_name);
+		return -1;
+	}
+	return 1;
+}
+
+/**
+ * @brief Processa a exclusão de um registro de vacinação com três argumentos:
+ * nome do usuário, data de vacinação e nome do lote de vacina.
+ * 
+ * @param vaccinationSystem O sistema de vacinação, utilizado para acessar
+ * os registros e lotes de vacinação.
+ * @param pt Indicador de linguagem para exibição de mensagens de erro no
+ * idioma correto.
+ * @param name O nome do usuário cujo registro de vacinação será deletado.
+ * @param date A data de vacinação a excluir.
+ * @param batch_name O ID do lote do registro a excluir.
+ * 
+ * @return Retorna o número de registros deletados ou -1 se ocorrer algum erro.
+ */
+int deleteRecordInput3Args(VaccinationSystem* vaccinationSystem, int pt, 
+	char* name, Date date, char* batch_name) {
+	if (validDeleteRecordInput3Args(vaccinationSystem, name, batch_name, 
+		date, pt) == -1) {
+		return -1;
+	}
+	return deleteRecordByNameDateAndBatchID(userRecords(vaccinationSystem, 
+		name), name, date, batch_name);
+}
+
+/**
+ * @brief Acrescenta ao diário a remoção de registros feita por um comando 
+ * `d` bem-sucedido.
+ * 
+ * @param vaccinationSystem O sistema de vacinação.
+ * @param tokens Argumentos do comando `d`.
+ * @param count Número de argumentos, incluindo o comando.
+ * @param pt Indicador de linguagem para exibição de mensagens de erro no
+ * idioma correto.
+ */
+void journalDeleteInput(VaccinationSystem* vaccinationSystem, Token* tokens, 
+	int count, int pt) {
+	Date date = createDate(0, 0, 0);
+	if (count > 2) tokenDate(&tokens[2], &date);
+	checkJournal(vaccinationSystem, journalDeleteRecords(
+		&vaccinationSystem->journal, tokens[1].text, 
+		count == 2 ? 0 : count == 3 ? JOURNAL_DELETE_DATE : 
+		JOURNAL_DELETE_DATE | JOURNAL_DELETE_BATCH, date, 
+		tokenText(tokens, count, 3)), pt);
+}
+
+/**
+ * @brief Processa a exclusão de um ou mais registros de vacinação com base
+ * no número de argumentos fornecidos na entrada.
+ * 
+ * @param vaccinationSystem O sistema de vacinação, utilizado para acessar
+ * os registros de vacinação.
+ * @param tokens Argumentos do comando: o nome do usuário e, opcionalmente, 
+ * a data de vacinação e o ID do lote.
+ * @param count Número de argumentos, incluindo o comando.
+ * @param pt Indicador de linguagem para exibição de mensagens de erro no
+ * idioma correto.
+ * 
+ * @return O número de registros apagados, -1 em caso de erro ou 
+ * RECORD_NO_MEMORY se faltar memória, caso em que nada é impresso.
+ */
+int deleteRecordInput(VaccinationSystem* vaccinationSystem, Token* tokens, 
+	int count, int pt) {
+	int deleted = 0;
+	Date date = createDate(0, 0, 0);
+	if (count > 2) tokenDate(&tokens[2], &date);
+	if (count == 2)
+		deleted = deleteRecordInput1Arg(vaccinationSystem, pt, 
+			tokens[1].text);
+	else if (count == 3)
+		deleted = deleteRecordInput2Args(vaccinationSystem, pt,
+			tokens[1].text, date);
+	else if (count == 4)
+		deleted = deleteRecordInput3Args(vaccinationSystem, pt,
+			tokens[1].text, date, batchIdToken(tokens, count, 3));
+	if (deleted == RECORD_NO_MEMORY) return deleted;
+	if (deleted != -1) printCount(vaccinationSystem, deleted);
+	if (deleted > 0) 
+		journalDeleteInput(vaccinationSystem, tokens, count, pt);
+	return deleted;
+}
+
+/**
+ * @brief Exibe os registros de vacinação de um usuário específico ou de todos
+ * os usuários, dependendo da entrada. As listagens longas são feitas 
+ * noutra thread.
+ * 
+ * @param vaccinationSystem O sistema de vacinação, utilizado para acessar
+ * os registros de vacinação.
+ * @param tokens Argumentos do comando, com o nome do usuário, se existir.
+ * @param count Número de argumentos, incluindo o comando.
+ * @param pt Indicador de linguagem para exibição de mensagens de erro no
+ * idioma correto.
+ */
+void listRecordsInput(VaccinationSystem* vaccinationSystem, Token* tokens, 
+	int count, int pt) {
+	VaccinationRecordsHashtable *records;
+	if (count == 1) {
+		if (!reportAllRecords(vaccinationSystem))
+			listAllRecordsInSystem(
+				vaccinationSystem->record_shards, 
+				vaccinationSystem->shard_count, 
+				&vaccinationSystem->output);
+		return;
+	}
+	records = userRecords(vaccinationSystem, tokens[1].text);
+	if (!userExistInSystem(records, tokens[1].text)) {
+		printErrorFormated(&vaccinationSystem->output,
+			ENOSUCHUSER, ENOSUCHUSERPT, pt, tokens[1].text);
+		return;
+	}
+	if (!reportUserRecords(vaccinationSystem, records, tokens[1].text))
+		listAllUserRecordsInSystem(records, &vaccinationSystem->output, 
+			tokens[1].text);
+}
+
+/**
+ * @brief Atualiza a data atual do sistema de vacinação com a data fornecida.
+ * 
+ * @param vaccinationSystem O sistema de vacinação, utilizado para alterar
+ * a data atual do sistema.
+ * @param tokens Argumentos do comando, com a nova data.
+ * @param count Número de argumentos, incluindo o comando.
+ * @param pt Indicador de linguagem para exibição de mensagens de erro no
+ * idioma correto.
+ */
+void passTimeInput(VaccinationSystem* vaccinationSystem, Token* tokens, 
+	int count, int pt) {
+	Date date = createDate(0, 0, 0);
+	if (count > 1) tokenDate(&tokens[1], &date);
+	if (!validDate(&vaccinationSystem->output, 
+		vaccinationSystem->current_date, date, pt)) return;
+	checkJournal(vaccinationSystem, journalPassTime(
+		&vaccinationSystem->journal, date), pt);
+	outputDate(&vaccinationSystem->output, date);
+	outputChar(&vaccinationSystem->output, '\n');
+	setSystemDate(vaccinationSystem, date);
+}
+
+/**
+ * @brief Guarda o estado do sistema de vacinação num snapshot, que pode ser 
+ * carregado mais tarde com a opção `--restore`, e descarta as entradas do 
+ * diário, já contidas no snapshot.
+ * 
+ * @param vaccinationSystem O sistema de vacinação a guardar.
+ * @param tokens Argumentos do comando, com o caminho do snapshot.
+ * @param count Número de argumentos, incluindo o comando.
+ * @param pt Indicador de linguagem para exibição de mensagens de erro no
+ * idioma correto.
+ */
+void snapshotInput(VaccinationSystem* vaccinationSystem, Token* tokens, 
+	int count, int pt) {
+	int result;
+	if (count < 2) {
+		printError(&vaccinationSystem->output, ESNAPSHOTPATH, 
+			ESNAPSHOTPATHPT, pt);
+		return;
+	}
+	result = saveSnapshot(vaccinationSystem, tokens[1].text);
+	if (result == -1) endProgramMemError(vaccinationSystem, pt);
+	if (result == 0)
+		printErrorFormated(&vaccinationSystem->output, ESNAPSHOTWRITE, 
+			ESNAPSHOTWRITEPT, pt, tokens[1].text);
+	else checkJournal(vaccinationSystem, 
+		checkpointJournal(&vaccinationSystem->journal), pt);
+}
+
+/**
+ * @brief Processa a entrada do comando que resume o stock das vacinas, a 
+ * partir dos contadores mantidos em cada vacina.
+ * 
+ * @param vaccinationSystem O sistema de vacinação.
+ * @param tokens Argumentos do comando, com os nomes das vacinas ou apenas o 
+ * comando para resumir todas as vacinas.
+ * @param count Número de argumentos, incluindo o comando.
+ * @param pt Indicador de linguagem para exibição de mensagens de erro no 
+ * idioma correto.
+ */
+void stockInput(VaccinationSystem* vaccinationSystem, Token* tokens, 
+	int count, int pt) {
+	char** vaccinesNames;
+	int i;
+	vaccinesNames = scratchAlloc(vaccinationSystem, sizeof(char*) * count, 
+		pt);
+	for (i = 0; i < count; i++) vaccinesNames[i] = tokens[i].text;
+	listStockInSystem(vaccinationSystem->batches_ht, 
+		&vaccinationSystem->output, vaccinesNames, count, pt);
+}
+
+/**
+ * @brief Prepara um comando: divide a linha em argumentos uma única vez e,
+ * no comando `c`, que é lido diretamente da linha, faz já as verificações 
+ * que não dependem do estado do sistema. No comando `a`, o último argumento
+ * é o resto da linha.
+ * 
+ * @param arena A arena onde são reservados os argumentos.
+ * @param input A linha do comando, terminada em '\0'.
+ * @param length O comprimento da linha.
+ * @param command O comando a preencher.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+int prepareCommand(Arena* arena, char* input, size_t length, 
+	Command* command) {
+	int max_tokens = (int)(length / 2 + 2);
+	command->input = input;
+	command->length = length;
+	command->tokens = NULL;
+	command->count = 0;
+	if (length == 0) return 1;
+	if (input[0] == 'c') max_tokens = CREATE_BATCH_TOKENS;
+	if (input[0] == 'a') max_tokens = APPLY_VACCINE_TOKENS;
+	command->tokens = arenaAlloc(arena, sizeof(Token) * max_tokens);
+	if (command->tokens == NULL) return 0;
+	if (input[0] == 'c') {
+		prepareCreateBatch(command);
+		return 1;
+	}
+	command->count = tokenizeCommand(input, length, command->tokens, 
+		max_tokens);
+	if (input[0] == 'a') prepareApplyVaccine(command);
+	return 1;
+}
+
+/**
+ * @brief Aplica um comando preparado ao sistema, chamando a função 
+ * correspondente. No modo com partições, os comandos de um só usuário são 
+ * entregues à thread da sua partição; os restantes só correm aqui depois de
+ * todos os comandos em curso terminarem.
+ * 
+ * @param vaccinationSystem O sistema de vacinação para gerenciar as
+ * operações relacionadas aos lotes e registros.
+ * @param command O comando preparado.
+ * @param pt Indicador de linguagem para exibição de mensagens de erro no
+ * idioma correto.
+ * 
+ * @return 0 se o comando for `q`, 1 caso contrário.
+ */
+int runCommand(VaccinationSystem* vaccinationSystem, Command* command, 
+	int pt) {
+	Token *tokens = command->tokens;
+	int count = command->count;
+	if (command->length == 0) return 1;
+	if (vaccinationSystem->shards != NULL && 
+		dispatchShardCommand(vaccinationSystem, command, pt)) return 1;
+	switch (command->input[0]) {
+		case 'q': 
+			return 0;
+		case 'c': 
+			createBatchInput(vaccinationSystem, command, pt);
+			break;
+		case 'l':
+			listBatchInput(vaccinationSystem, tokens, count, pt);
+			break;
+		case 'a':
+			applyVaccineInput(vaccinationSystem, tokens, count, pt);
+			break;
+		case 'r':
+			removeBatchInput(vaccinationSystem, tokens, count, pt);
+			break;
+		case 'd':
+			if (deleteRecordInput(vaccinationSystem, tokens, count, 
+				pt) == RECORD_NO_MEMORY)
+				endProgramMemError(vaccinationSystem, pt);
+			break;
+		case 'u':
+			listRecordsInput(vaccinationSystem, tokens, count, pt);
+			break;
+		case 't':
+			passTimeInput(vaccinationSystem, tokens, count, pt);
+			break;
+		case 's':
+			snapshotInput(vaccinationSystem, tokens, count, pt);
+			break;
+		case 'e': 
+			stockInput(vaccinationSystem, tokens, count, pt);
+			break;
+		case 'v':
+			listBatchesBeforeInput(vaccinationSystem, tokens, 
+				count, pt);
+			break;
+		default: break;
+	}
+	return 1;
+}
+
+/**
+ * @brief Processa a entrada do usuário: prepara o comando na arena de 
+ * rascunho do sistema e aplica-o de seguida.
+ * 
+ * @param vaccinationSystem O sistema de vacinação para gerenciar as
+ * operações relacionadas aos lotes e registros.
+ * @param input A entrada do usuário contendo o comando e os dados, terminada
+ * em '\0'.
+ * @param length O comprimento da entrada.
+ * @param pt Indicador de linguagem para exibição de mensagens de erro no
+ * idioma correto.
+ * 
+ * @return 0 se o comando for `q`, 1 caso contrário.
+ */
+int handleInputSwitch(VaccinationSystem* vaccinationSystem, char* input, 
+	size_t length, int pt) {
+	Command command;
+	if (!prepareCommand(&vaccinationSystem->scratch, input, length, 
+		&command)) endProgramMemError(vaccinationSystem, pt);
+	return runCommand(vaccinationSystem, &command, pt);
+}
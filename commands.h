@@ -0,0 +1,56 @@
+/**
+ * @file commands.h
+ * @author Diogo Lobo (ist1109293)
+ * @brief Cabeçalho dos comandos do sistema de vacinação. Separa a 
+ * preparação de um comando, que só lê a própria linha, da sua aplicação ao 
+ * estado do sistema, para que a preparação possa correr em paralelo.
+ * @date 2026-10-16
+ */
+
+#ifndef COMMANDS_H
+#define COMMANDS_H
+
+#include <stddef.h>
+#include "arena.h"
+#include "date.h"
+#include "system.h"
+#include "tokenizer.h"
+
+/** Estrutura que representa um comando já dividido em argumentos e, no 
+ * comando `c`, já validado em tudo o que não depende do estado. */
+typedef struct Command {
+    char *input; /** Linha do comando, terminada em '\0'. */
+    size_t length; /** Comprimento da linha. */
+    Token *tokens; /** Argumentos, começando pelo próprio comando. */
+    int count; /** Número de argumentos. */
+    Date date; /** Data do lote, no comando `c`. */
+    int doses; /** Número de doses do lote, no comando `c`. */
+    int valid_batch; /** 1 se o ID do lote tem formato válido. */
+    int valid_name; /** 1 se o nome da vacina tem formato válido. */
+} Command;
+
+void endProgram(VaccinationSystem* vaccinationSystem, int error);
+void endProgramMemError(VaccinationSystem* vaccinationSystem, int pt);
+void checkJournal(VaccinationSystem* vaccinationSystem, int result, int pt);
+
+char* tokenText(Token* tokens, int count, int i);
+
+int deleteRecordInput(VaccinationSystem* vaccinationSystem, Token* tokens, 
+int count, int pt);
+
+void journalDeleteInput(VaccinationSystem* vaccinationSystem, Token* tokens, 
+int count, int pt);
+
+void listRecordsInput(VaccinationSystem* vaccinationSystem, Token* tokens, 
+int count, int pt);
+
+int prepareCommand(Arena* arena, char* input, size_t length, 
+Command* command);
+
+int runCommand(VaccinationSystem* vaccinationSystem, Command* command, 
+int pt);
+
+int handleInputSwitch(VaccinationSystem* vaccinationSystem, char* input, 
+size_t length, int pt);
+
+#endif
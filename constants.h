@@ -9,7 +9,8 @@
 #ifndef CONSTANTS_H
 #define CONSTANTS_H
 
-/** Tamanho do buffer para leitura de dados. */
+/** Tamanho de referência de uma linha de comando, usado para dimensionar a
+ * arena de rascunho. */
 #define BUFFER_SIZE 65535
 
 /** Tamanho máximo permitido para o nome de uma vacina. */
@@ -18,9 +19,26 @@
 /** Tamanho máximo permitido para o nome de um lote. */
 #define MAX_BATCH_NAME_SIZE 20
 
-/** Número máximo de lotes que o sistema pode armazenar. */
+/** Número máximo de lotes que o sistema pode armazenar, por padrão. Pode 
+ * ser alterado com a opção `--max-batches`. */
 #define MAX_BATCHES_NUMBER 1000
 
+/** Número máximo de partições dos registros de vacinação, escolhido com a 
+ * opção `--shards`. */
+#define MAX_SHARDS 64
+
+/** Capacidade inicial da arena de rascunho de cada comando, suficiente para
+ * a linha lida e todos os valores temporários de uma linha completa. */
+#define SCRATCH_ARENA_SIZE (8 * (BUFFER_SIZE + 1))
+
+/** Número de argumentos do comando `c`, incluindo o próprio comando. O
+ * último argumento, o nome da vacina, é o resto da linha. */
+#define CREATE_BATCH_TOKENS 5
+
+/** Número de argumentos do comando `a`, incluindo o próprio comando. O
+ * último argumento, o nome da vacina, é o resto da linha. */
+#define APPLY_VACCINE_TOKENS 3
+
 /** Comprimento máximo permitido para o nome de um usuário. */
 #define MAX_USER_LENGTH 200
 
@@ -93,4 +111,44 @@
 /** Mensagem de erro para usuário inexistente (em português). */
 #define ENOSUCHUSERPT "utente inexistente"
 
+/** Mensagem de erro para arquivo de importação que não pode ser aberto. */
+#define EIMPORTFILE "cannot open import file"
+/** Mensagem de erro para arquivo de importação que não pode ser aberto (em 
+ * português). */
+#define EIMPORTFILEPT "não foi possível abrir o arquivo de importação"
+
+/** Mensagem de erro para entrada que não pode ser lida. */
+#define EINPUTREAD "cannot read input"
+/** Mensagem de erro para entrada que não pode ser lida (em português). */
+#define EINPUTREADPT "não foi possível ler a entrada"
+
+/** Mensagem de erro para snapshot que não pode ser escrito. */
+#define ESNAPSHOTWRITE "cannot write snapshot"
+/** Mensagem de erro para snapshot que não pode ser escrito (em 
+ * português). */
+#define ESNAPSHOTWRITEPT "não foi possível escrever o snapshot"
+
+/** Mensagem de erro para o comando de snapshot sem caminho. */
+#define ESNAPSHOTPATH "missing snapshot path"
+/** Mensagem de erro para o comando de snapshot sem caminho (em português). */
+#define ESNAPSHOTPATHPT "caminho do snapshot em falta"
+
+/** Mensagem de erro para snapshot que não pode ser lido ou é inválido. */
+#define ESNAPSHOTREAD "cannot read snapshot"
+/** Mensagem de erro para snapshot que não pode ser lido ou é inválido (em 
+ * português). */
+#define ESNAPSHOTREADPT "não foi possível ler o snapshot"
+
+/** Mensagem de erro para diário que não pode ser aberto ou é inválido. */
+#define EJOURNALREAD "cannot open journal"
+/** Mensagem de erro para diário que não pode ser aberto ou é inválido (em 
+ * português). */
+#define EJOURNALREADPT "não foi possível abrir o diário"
+
+/** Mensagem de erro para mutação que não pode ser escrita no diário. */
+#define EJOURNALWRITE "cannot write journal"
+/** Mensagem de erro para mutação que não pode ser escrita no diário (em 
+ * português). */
+#define EJOURNALWRITEPT "não foi possível escrever no diário"
+
 #endif
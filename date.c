@@ -2,54 +2,81 @@
  * @file date.c
  * @author Diogo Lobo (ist1109293)
  * @brief Implementa funções relacionadas a datas, como criação, 
- * cópia, comparação, verificação de ano bissexto, e validação de datas.
+ * decomposição, comparação, verificação de ano bissexto, e validação de datas.
  * @date 2025-04-07
  */
 
-#include <stdlib.h>
 #include "date.h"
 #include "constants.h"
 #include "utils.h"
 
 
+/**
+ * @brief Limita um campo da data ao intervalo [0, DATE_FIELD_MAX], mantendo
+ * a ordem entre valores fora do intervalo e valores válidos.
+ * 
+ * @param field O valor do campo.
+ * 
+ * @return O valor limitado.
+ */
+int clampDateField(int field) {
+	if (field < 0) return 0;
+	if (field > DATE_FIELD_MAX) return DATE_FIELD_MAX;
+	return field;
+}
+
 /**
  * @brief Cria uma nova data com os valores fornecidos para o dia, mês e ano.
+ * Valores fora da representação compacta são limitados de forma a preservar
+ * a ordem e a invalidade da data.
  * 
  * @param day O dia da data.
  * @param month O mês da data.
  * @param year O ano da data.
  * 
- * @return Uma nova estrutura de data com os valores fornecidos, 
- * ou NULL se falhar.
+ * @return A data no formato compacto aaaammdd.
  */
 Date createDate(int day, int month, int year) {
-	Date date;
-	date = (Date)malloc(sizeof(struct Date));
-	if (date != NULL) {
-		date->day = day;
-		date->month = month;
-		date->year = year;
-	}
-	return date;
+	if (year < 0) return 0;
+	if (year >= DATE_MAX_YEAR)
+		return DATE_MAX_YEAR * DATE_YEAR_FACTOR + 
+			DATE_FIELD_MAX * DATE_MONTH_FACTOR + DATE_FIELD_MAX;
+	return (unsigned int)year * DATE_YEAR_FACTOR + 
+		(unsigned int)clampDateField(month) * DATE_MONTH_FACTOR + 
+		(unsigned int)clampDateField(day);
 }
 
 /**
- * @brief Cria uma cópia de uma data existente.
+ * @brief Devolve o dia de uma data.
  * 
- * @param date A data a ser copiada.
+ * @param date A data.
  * 
- * @return Uma nova estrutura de data com os 
- * mesmos valores da data fornecida, ou NULL se falhar.
+ * @return O dia da data.
  */
-Date copyDate(Date date) {
-	Date new_date;
-	new_date = (Date)malloc(sizeof(struct Date));
-	if (new_date != NULL) {
-		new_date->day = date->day;
-		new_date->month = date->month;
-		new_date->year = date->year;
-	}
-	return new_date;
+int dateDay(Date date) {
+	return date % DATE_MONTH_FACTOR;
+}
+
+/**
+ * @brief Devolve o mês de uma data.
+ * 
+ * @param date A data.
+ * 
+ * @return O mês da data.
+ */
+int dateMonth(Date date) {
+	return date / DATE_MONTH_FACTOR % DATE_MONTH_FACTOR;
+}
+
+/**
+ * @brief Devolve o ano de uma data.
+ * 
+ * @param date A data.
+ * 
+ * @return O ano da data.
+ */
+int dateYear(Date date) {
+	return date / DATE_YEAR_FACTOR;
 }
 
 /**
@@ -97,15 +124,7 @@ int days_of_month(int month, int year) {
  * 0 se forem iguais.
  */
 int compareDate1Date2(Date date1, Date date2) {
-	if (date1->year > date2->year) return 1;
-	if (date1->year < date2->year) return -1;
-
-	if (date1->month > date2->month) return 1;
-	if (date1->month < date2->month) return -1;
-
-	if (date1->day > date2->day) return 1;
-	if (date1->day < date2->day) return -1;
-	return 0;
+	return (date1 > date2) - (date1 < date2);
 }
 
 /**
@@ -117,13 +136,28 @@ int compareDate1Date2(Date date1, Date date2) {
  * @return 1 se a vacina estiver vencida, 0 caso contrário.
  */
 int expiredVaccineDate(Date system_date, Date date) {
-	return compareDate1Date2(system_date, date) > 0;
+	return system_date > date;
+}
+
+/**
+ * @brief Verifica se uma data existe no calendário, com o ano abaixo de 
+ * DATE_MAX_YEAR, sem a comparar com a data do sistema.
+ * 
+ * @param date A data a verificar.
+ * 
+ * @return 1 se a data existir, 0 caso contrário.
+ */
+int validCalendarDate(Date date) {
+	int day = dateDay(date), month = dateMonth(date), year = dateYear(date);
+	return year < DATE_MAX_YEAR && 1 <= month && month <= 12 && 
+		1 <= day && day <= days_of_month(month, year);
 }
 
 /**
  * @brief Valida se uma data fornecida é válida, verificando o ano, mês, dia 
  * e se não está expirada.
  * 
+ * @param out O escritor de saída onde o erro é escrito.
  * @param system_date A data atual do sistema.
  * @param date A data a ser validada.
  * @param pt Um valor que indica se a mensagem de erro será impressa em 
@@ -131,13 +165,9 @@ int expiredVaccineDate(Date system_date, Date date) {
  * 
  * @return 1 se a data for válida, 0 caso contrário.
  */
-int validDate(Date system_date, Date date, int pt) {
-	if (date->year < 0 || 
-		!(1 <= date->month && date->month <= 12) || 
-		!(1 <= date->day && 
-			date->day <= days_of_month(date->month, date->year)) ||
-		expiredVaccineDate(system_date, date)) {
-		printError(EINVALIDDATE, EINVALIDDATEPT, pt);
+int validDate(Output* out, Date system_date, Date date, int pt) {
+	if (!validCalendarDate(date) || expiredVaccineDate(system_date, date)) {
+		printError(out, EINVALIDDATE, EINVALIDDATEPT, pt);
 		return 0;
 	}
 	return 1;
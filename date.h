@@ -10,23 +10,33 @@
 #ifndef DATE_H
 #define DATE_H
 
-
-/** Estrutura que representa uma data com dia, mês e ano. */
-struct Date {
-    int day; /** O dia da data. */
-    int month; /** O mês da data. */
-    int year; /** O ano da data. */
-};
+/** Fator que multiplica o ano na representação compacta da data. */
+#define DATE_YEAR_FACTOR 10000u
+/** Fator que multiplica o mês na representação compacta da data. */
+#define DATE_MONTH_FACTOR 100u
+/** Maior valor admitido para o dia e o mês na representação compacta. */
+#define DATE_FIELD_MAX 99
+/** Primeiro ano que já não cabe na representação compacta. Datas com anos
+ * iguais ou superiores são guardadas como a maior data possível, que é
+ * sempre inválida. */
+#define DATE_MAX_YEAR 400000
 
 /** Enumeração dos meses do ano. */
 enum Meses{JAN=1, FEB, MAR, APR, MAY, JUNE, JULY, AUG, SEPT, OCT, NOV, DEC};
 
-/** Tipo Date, que é um ponteiro para a estrutura Date. */
-typedef struct Date* Date;
+/** Tipo Date, que representa uma data como um inteiro de 32 bits no formato
+ * aaaammdd (ano * 10000 + mês * 100 + dia). A ordem dos inteiros coincide com
+ * a ordem cronológica, pelo que as datas são comparadas diretamente. */
+typedef unsigned int Date;
 
-Date copyDate(Date date);
+Date createDate(int day, int month, int year);
+int dateDay(Date date);
+int dateMonth(Date date);
+int dateYear(Date date);
 int compareDate1Date2(Date date1, Date date2);
 int expiredVaccineDate(Date system_date, Date date);
-int validDate(Date system_date, Date date, int pt);
+struct Output;
+int validCalendarDate(Date date);
+int validDate(struct Output* out, Date system_date, Date date, int pt);
 
 #endif
@@ -0,0 +1,131 @@
+/**
+ * @file epoch.c
+ * @author Diogo Lobo (ist1109293)
+ * @brief Implementação da liberação por épocas.
+ * @date 2026-10-16
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "epoch.h"
+
+/**
+ * @brief Inicializa o relógio das épocas, sem leituras em curso.
+ * 
+ * @param clock O relógio.
+ */
+void initEpochClock(EpochClock *clock) {
+	atomic_init(&clock->current, 0);
+	atomic_init(&clock->safe, 0);
+}
+
+/**
+ * @brief Inicializa uma lista de objetos retirados, vazia.
+ * 
+ * @param list A lista.
+ * @param clock O relógio do sistema, ou NULL para liberar os objetos logo.
+ */
+void initRetireList(RetireList *list, EpochClock *clock) {
+	list->clock = clock;
+	list->objects = NULL;
+	list->first = list->count = list->capacity = 0;
+}
+
+/**
+ * @brief Libera os objetos retirados que já nenhuma leitura pode ver. Como 
+ * a lista está por ordem de época, são sempre os primeiros.
+ * 
+ * @param list A lista.
+ */
+void reclaimRetired(RetireList *list) {
+	unsigned long long safe;
+	RetiredObject *retired;
+	if (list->clock == NULL || list->first == list->count) return;
+	safe = atomic_load(&list->clock->safe);
+	while (list->first < list->count && 
+		(retired = &list->objects[list->first])->epoch <= safe) {
+		retired->destroy(retired->object);
+		list->first++;
+	}
+	if (list->first == list->count) list->first = list->count = 0;
+}
+
+/**
+ * @brief Garante espaço para mais `count` objetos no fim da lista, 
+ * aproveitando primeiro as posições já liberadas. Quem retira vários 
+ * objetos de uma vez reserva antes de alterar as tabelas, para que nenhuma 
+ * das retiradas falhe a meio.
+ * 
+ * @param list A lista.
+ * @param count O número de objetos a retirar.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+int reserveRetired(RetireList *list, int count) {
+	RetiredObject *objects;
+	int capacity;
+	if (list->clock == NULL) return 1;
+	reclaimRetired(list);
+	if (list->count + count <= list->capacity) return 1;
+	if (list->first > 0) {
+		list->count -= list->first;
+		memmove(list->objects, list->objects + list->first, 
+			sizeof(RetiredObject) * list->count);
+		list->first = 0;
+		if (list->count + count <= list->capacity) return 1;
+	}
+	capacity = list->capacity == 0 ? RETIRE_LIST_SIZE : list->capacity * 2;
+	while (capacity < list->count + count) capacity *= 2;
+	objects = realloc(list->objects, sizeof(RetiredObject) * capacity);
+	if (objects == NULL) return 0;
+	list->objects = objects;
+	list->capacity = capacity;
+	return 1;
+}
+
+/**
+ * @brief Retira um objeto que deixou de estar nas tabelas. Se nenhuma 
+ * leitura em curso o pode ver, é liberado logo; senão fica na lista até a 
+ * última dessas leituras terminar. Nunca falha se o espaço tiver sido 
+ * reservado com reserveRetired.
+ * 
+ * @param list A lista da tabela de onde o objeto foi retirado.
+ * @param object O objeto.
+ * @param destroy A função que o libera.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória para guardar o objeto, 
+ * que continua a pertencer a quem o retirou.
+ */
+int retireObject(RetireList *list, void *object, RetireFunction destroy) {
+	unsigned long long epoch;
+	if (list->clock == NULL) {
+		destroy(object);
+		return 1;
+	}
+	reclaimRetired(list);
+	epoch = atomic_load(&list->clock->current);
+	if (epoch <= atomic_load(&list->clock->safe)) {
+		destroy(object);
+		return 1;
+	}
+	if (!reserveRetired(list, 1)) return 0;
+	list->objects[list->count].object = object;
+	list->objects[list->count].destroy = destroy;
+	list->objects[list->count].epoch = epoch;
+	list->count++;
+	return 1;
+}
+
+/**
+ * @brief Libera todos os objetos retirados e a própria lista. Só pode ser 
+ * chamada depois de terminarem todas as leituras concorrentes.
+ * 
+ * @param list A lista.
+ */
+void destroyRetireList(RetireList *list) {
+	int i;
+	for (i = list->first; i < list->count; i++)
+		list->objects[i].destroy(list->objects[i].object);
+	free(list->objects);
+	initRetireList(list, list->clock);
+}
@@ -0,0 +1,63 @@
+/**
+ * @file epoch.h
+ * @author Diogo Lobo (ist1109293)
+ * @brief Cabeçalho da liberação por épocas. Os objetos retirados das 
+ * tabelas enquanto há leituras concorrentes em curso (relatórios escritos 
+ * noutras threads) só são liberados quando nenhuma dessas leituras os pode 
+ * ainda ver.
+ * @date 2026-10-16
+ */
+
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include <stdatomic.h>
+
+/** Capacidade inicial da lista de objetos retirados. */
+#define RETIRE_LIST_SIZE 64
+
+/** Função que libera um objeto retirado. */
+typedef void (*RetireFunction)(void *object);
+
+/** Estrutura que representa o relógio das épocas do sistema. Cada leitura 
+ * concorrente fixa a época atual e faz o relógio avançar; um objeto 
+ * retirado na época e só pode ser visto pelas leituras de épocas 
+ * anteriores a e. */
+typedef struct EpochClock {
+    atomic_ullong current; /** Época atual. */
+    atomic_ullong safe; /** Época da leitura em curso mais antiga, ou a 
+    época atual se não houver nenhuma; os objetos retirados até esta época 
+    podem ser liberados. */
+} EpochClock;
+
+/** Objeto retirado à espera de poder ser liberado. */
+typedef struct RetiredObject {
+    void *object; /** Objeto retirado. */
+    RetireFunction destroy; /** Função que o libera. */
+    unsigned long long epoch; /** Época em que foi retirado. */
+} RetiredObject;
+
+/** Estrutura que representa os objetos retirados de uma tabela, usada só 
+ * pela thread dona da tabela. */
+typedef struct RetireList {
+    EpochClock *clock; /** Relógio do sistema, ou NULL para liberar os 
+    objetos logo. */
+    RetiredObject *objects; /** Objetos retirados, por ordem de época. */
+    int first; /** Primeiro objeto ainda por liberar. */
+    int count; /** Número de posições ocupadas. */
+    int capacity; /** Capacidade da lista. */
+} RetireList;
+
+void initEpochClock(EpochClock *clock);
+
+void initRetireList(RetireList *list, EpochClock *clock);
+
+int reserveRetired(RetireList *list, int count);
+
+int retireObject(RetireList *list, void *object, RetireFunction destroy);
+
+void reclaimRetired(RetireList *list);
+
+void destroyRetireList(RetireList *list);
+
+#endif
@@ -0,0 +1,403 @@
+/**
+ * @file hashtable.c
+ * @author Diogo Lobo (ist1109293)
+ * @brief Implementação da tabela de hash de endereçamento aberto com 
+ * sondagem linear Robin Hood.
+ * @date 2026-10-16
+ */
+
+/** Expõe clock_gettime, que é POSIX, mesmo quando se compila em C99 estrito. */
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/random.h>
+#include "hashtable.h"
+#include "constants.h"
+
+/** Constantes de mistura do código de hash, as mesmas do wyhash. */
+#define HASH_SECRET0 0xa0761d6478bd642full
+#define HASH_SECRET1 0xe7037ed1a0b428dbull
+#define HASH_SECRET2 0x8ebc6af09c88c6e3ull
+#define HASH_SECRET3 0x589965cc75374cc3ull
+
+/**
+ * @brief Multiplica dois valores de 64 bits e combina as duas metades do 
+ * produto de 128 bits, a operação de mistura do código de hash. Sem 
+ * inteiros de 128 bits, ou em C ISO estrito, o produto é composto a partir 
+ * de metades de 32 bits, com o mesmo resultado.
+ * 
+ * @param a O primeiro valor.
+ * @param b O segundo valor.
+ * 
+ * @return A combinação das duas metades do produto.
+ */
+uint64_t hashMix(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__) && !defined(__STRICT_ANSI__)
+	unsigned __int128 product = (unsigned __int128)a * b;
+	return (uint64_t)product ^ (uint64_t)(product >> 64);
+#else
+	uint64_t a_low = a & 0xffffffffu, a_high = a >> 32;
+	uint64_t b_low = b & 0xffffffffu, b_high = b >> 32;
+	uint64_t low = a_low * b_low, middle1 = a_high * b_low;
+	uint64_t middle2 = a_low * b_high, high = a_high * b_high;
+	uint64_t carry = ((low >> 32) + (middle1 & 0xffffffffu) + 
+		(middle2 & 0xffffffffu)) >> 32;
+	high += (middle1 >> 32) + (middle2 >> 32) + carry;
+	return (a * b) ^ high;
+#endif
+}
+
+/**
+ * @brief Lê até 8 bytes de uma chave como um valor de 64 bits, completando 
+ * com zeros.
+ * 
+ * @param bytes Os bytes a ler.
+ * @param length O número de bytes, no máximo 8.
+ * 
+ * @return O valor lido.
+ */
+uint64_t readHashWord(const unsigned char *bytes, size_t length) {
+	uint64_t word = 0;
+	memcpy(&word, bytes, length);
+	return word;
+}
+
+/**
+ * @brief Calcula o código de hash de 64 bits de um bloco de bytes, ao estilo
+ * do wyhash: o bloco é lido 16 bytes de cada vez e cada parte é misturada 
+ * com uma multiplicação de 128 bits. Os bytes são lidos sem sinal, pelo que 
+ * nomes em UTF-8 são dispersos como quaisquer outros.
+ * 
+ * @param data Os bytes a dispersar.
+ * @param length O número de bytes.
+ * @param seed A semente.
+ * 
+ * @return O código de hash dos bytes.
+ */
+uint64_t hashBytes(const void *data, size_t length, uint64_t seed) {
+	const unsigned char *bytes = (const unsigned char*)data;
+	size_t left = length;
+	uint64_t h = seed ^ HASH_SECRET0;
+	for (; left > 16; left -= 16, bytes += 16)
+		h = hashMix(readHashWord(bytes, 8) ^ HASH_SECRET1, 
+			readHashWord(bytes + 8, 8) ^ h);
+	if (left > 8) {
+		h = hashMix(readHashWord(bytes, 8) ^ HASH_SECRET1, 
+			readHashWord(bytes + 8, left - 8) ^ h);
+	} else {
+		h = hashMix(readHashWord(bytes, left) ^ HASH_SECRET1, 
+			HASH_SECRET2 ^ h);
+	}
+	return hashMix(h ^ HASH_SECRET3, (uint64_t)length ^ HASH_SECRET1);
+}
+
+/**
+ * @brief Calcula o código de hash de 64 bits de uma string.
+ * 
+ * @param key A string a dispersar.
+ * @param seed A semente da tabela.
+ * 
+ * @return O código de hash da string.
+ */
+uint64_t hashString(const char *key, uint64_t seed) {
+	return hashBytes(key, strlen(key), seed);
+}
+
+/**
+ * @brief Escolhe uma semente aleatória para o código de hash. Se o sistema 
+ * não fornecer bytes aleatórios, a semente é derivada do relógio, do 
+ * processo e do endereço da pilha.
+ * 
+ * @return A semente.
+ */
+uint64_t randomHashSeed() {
+	uint64_t seed = 0;
+	struct timespec now;
+	if (getrandom(&seed, sizeof(seed), GRND_NONBLOCK) == sizeof(seed)) 
+		return seed;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	seed = ((uint64_t)now.tv_sec << 32) ^ (uint64_t)now.tv_nsec;
+	seed ^= (uint64_t)getpid() << 16 ^ (uint64_t)(uintptr_t)&seed;
+	return hashMix(seed ^ HASH_SECRET0, HASH_SECRET1);
+}
+
+/**
+ * @brief Reserva um vetor de posições, todas livres.
+ * 
+ * @param slots O vetor a reservar.
+ * @param capacity O número de posições, potência de dois.
+ * 
+ * @return 1 em caso de sucesso, 0 se a alocação falhar.
+ */
+int allocHashSlots(HashSlots *slots, size_t capacity) {
+	slots->slots = (HashSlot*)calloc(capacity, sizeof(HashSlot));
+	if (slots->slots == NULL) return 0;
+	slots->capacity = capacity;
+	slots->count = 0;
+	return 1;
+}
+
+/**
+ * @brief Libera um vetor de posições, deixando-o vazio.
+ * 
+ * @param slots O vetor a liberar.
+ */
+void freeHashSlots(HashSlots *slots) {
+	free(slots->slots);
+	slots->slots = NULL;
+	slots->capacity = slots->count = 0;
+}
+
+/**
+ * @brief Inicializa uma tabela vazia com a capacidade mínima.
+ * 
+ * @param ht A tabela a inicializar.
+ * @param key A função que devolve a chave de cada entrada.
+ * 
+ * @return 1 em caso de sucesso, 0 se a alocação falhar.
+ */
+int initHashTable(HashTable *ht, HashKeyFunction key) {
+	ht->count = 0;
+	ht->key = key;
+	ht->seed = randomHashSeed();
+	ht->migrate_index = 0;
+	ht->previous.slots = NULL;
+	ht->previous.capacity = ht->previous.count = 0;
+	return allocHashSlots(&ht->current, HASH_TABLE_MIN_CAPACITY);
+}
+
+/**
+ * @brief Calcula a distância de uma posição ocupada à posição ideal da sua
+ * entrada.
+ * 
+ * @param slots O vetor de posições.
+ * @param hash O código de hash da entrada.
+ * @param i A posição ocupada pela entrada.
+ * 
+ * @return A distância de sondagem.
+ */
+size_t probeDistance(HashSlots *slots, uint64_t hash, size_t i) {
+	return (i - (hash & (slots->capacity - 1))) & (slots->capacity - 1);
+}
+
+/**
+ * @brief Coloca uma entrada num vetor de posições, que tem de ter uma 
+ * posição livre. Quem está mais longe da sua posição ideal fica com a 
+ * posição, e a entrada desalojada continua a sondagem.
+ * 
+ * @param slots O vetor de posições.
+ * @param hash O código de hash da entrada.
+ * @param entry A entrada a colocar.
+ */
+void placeHashEntry(HashSlots *slots, uint64_t hash, void *entry) {
+	size_t mask = slots->capacity - 1, i = hash & mask, distance = 0, other;
+	HashSlot slot = {hash, entry}, swap;
+	while (slots->slots[i].entry != NULL) {
+		other = probeDistance(slots, slots->slots[i].hash, i);
+		if (other < distance) {
+			swap = slots->slots[i];
+			slots->slots[i] = slot;
+			slot = swap;
+			distance = other;
+		}
+		i = (i + 1) & mask;
+		distance++;
+	}
+	slots->slots[i] = slot;
+	slots->count++;
+}
+
+/**
+ * @brief Retira a entrada de uma posição. As entradas seguintes da mesma 
+ * sequência recuam uma posição, pelo que não ficam marcas de posições 
+ * apagadas e o vetor continua válido para pesquisas.
+ * 
+ * @param slots O vetor de posições.
+ * @param i A posição a libertar.
+ */
+void removeHashSlot(HashSlots *slots, size_t i) {
+	size_t mask = slots->capacity - 1, next = (i + 1) & mask;
+	while (slots->slots[next].entry != NULL && 
+		probeDistance(slots, slots->slots[next].hash, next) > 0) {
+		slots->slots[i] = slots->slots[next];
+		i = next;
+		next = (next + 1) & mask;
+	}
+	slots->slots[i].entry = NULL;
+	slots->count--;
+}
+
+/**
+ * @brief Procura a posição da entrada com a chave indicada num vetor. A 
+ * sondagem termina numa posição livre ou quando a entrada encontrada está 
+ * mais perto da sua posição ideal do que a chave procurada estaria.
+ * 
+ * @param ht A tabela, que fornece a função de chave.
+ * @param slots O vetor de posições.
+ * @param key A chave a procurar.
+ * @param hash O código de hash da chave.
+ * 
+ * @return A posição encontrada, ou NULL se a chave não existir.
+ */
+HashSlot* findHashSlot(HashTable *ht, HashSlots *slots, const char *key, 
+	uint64_t hash) {
+	size_t mask = slots->capacity - 1, i = hash & mask, distance = 0;
+	HashSlot *slot;
+	if (slots->count == 0) return NULL;
+	while (1) {
+		slot = &slots->slots[i];
+		if (slot->entry == NULL || 
+			probeDistance(slots, slot->hash, i) < distance) 
+			return NULL;
+		if (slot->hash == hash && 
+			strcmp(ht->key(slot->entry), key) == 0) return slot;
+		i = (i + 1) & mask;
+		distance++;
+	}
+}
+
+/**
+ * @brief Migra para o vetor atual algumas posições do vetor anterior a um
+ * redimensionamento, no máximo HASH_MIGRATE_STEP. As posições antes de 
+ * `migrate_index` do vetor anterior estão sempre livres; quando o vetor 
+ * anterior fica vazio é liberado.
+ * 
+ * @param ht A tabela.
+ */
+void migrateHashSlots(HashTable *ht) {
+	HashSlots *previous = &ht->previous;
+	HashSlot *slot;
+	int step;
+	for (step = 0; step < HASH_MIGRATE_STEP && previous->count > 0; 
+		step++) {
+		slot = &previous->slots[ht->migrate_index];
+		if (slot->entry == NULL) {
+			ht->migrate_index++;
+			continue;
+		}
+		placeHashEntry(&ht->current, slot->hash, slot->entry);
+		removeHashSlot(previous, ht->migrate_index);
+	}
+	if (previous->slots != NULL && previous->count == 0) 
+		freeHashSlots(previous);
+}
+
+/**
+ * @brief Começa a mudar a capacidade da tabela. O vetor atual passa a ser o
+ * anterior e as suas entradas são migradas aos poucos, a cada inserção ou 
+ * remoção, com os códigos de hash já guardados, sem voltar a ler as chaves. 
+ * Uma migração ainda por terminar é concluída antes.
+ * 
+ * @param ht A tabela.
+ * @param capacity A nova capacidade, potência de dois.
+ * 
+ * @return 1 em caso de sucesso, 0 se a alocação falhar.
+ */
+int resizeHashTable(HashTable *ht, size_t capacity) {
+	HashSlots slots;
+	while (ht->previous.slots != NULL) migrateHashSlots(ht);
+	if (!allocHashSlots(&slots, capacity)) return 0;
+	ht->previous = ht->current;
+	ht->current = slots;
+	ht->migrate_index = 0;
+	migrateHashSlots(ht);
+	return 1;
+}
+
+/**
+ * @brief Procura a entrada com a chave indicada, no vetor atual e, durante
+ * uma migração, também no anterior.
+ * 
+ * @param ht A tabela.
+ * @param key A chave a procurar.
+ * 
+ * @return A entrada, ou NULL se não existir.
+ */
+void* hashTableFind(HashTable *ht, const char *key) {
+	uint64_t hash = hashString(key, ht->seed);
+	HashSlot *slot = findHashSlot(ht, &ht->current, key, hash);
+	if (slot == NULL) slot = findHashSlot(ht, &ht->previous, key, hash);
+	return slot != NULL ? slot->entry : NULL;
+}
+
+/**
+ * @brief Insere uma entrada cuja chave ainda não existe na tabela, 
+ * duplicando a capacidade quando a carga atinge MAX_LOAD_FACTOR. As 
+ * entradas novas vão sempre para o vetor atual.
+ * 
+ * @param ht A tabela.
+ * @param entry A entrada a inserir.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+int hashTableInsert(HashTable *ht, void *entry) {
+	migrateHashSlots(ht);
+	if ((float)(ht->count + 1) / ht->current.capacity > MAX_LOAD_FACTOR && 
+		!resizeHashTable(ht, ht->current.capacity * 2)) return 0;
+	placeHashEntry(&ht->current, hashString(ht->key(entry), ht->seed), 
+		entry);
+	ht->count++;
+	return 1;
+}
+
+/**
+ * @brief Retira a entrada com a chave indicada. A capacidade só é reduzida 
+ * a metade quando a carga desce abaixo de HASH_SHRINK_LOAD_FACTOR, bem 
+ * longe do limite de crescimento, para que inserções e remoções alternadas
+ * não provoquem redimensionamentos sucessivos; se a redução falhar, a 
+ * tabela continua válida.
+ * 
+ * @param ht A tabela.
+ * @param key A chave a retirar.
+ * 
+ * @return A entrada retirada, ou NULL se não existir.
+ */
+void* hashTableRemove(HashTable *ht, const char *key) {
+	uint64_t hash = hashString(key, ht->seed);
+	HashSlots *slots = &ht->current;
+	HashSlot *slot = findHashSlot(ht, slots, key, hash);
+	void *entry;
+	if (slot == NULL) {
+		slots = &ht->previous;
+		slot = findHashSlot(ht, slots, key, hash);
+		if (slot == NULL) return NULL;
+	}
+	entry = slot->entry;
+	removeHashSlot(slots, (size_t)(slot - slots->slots));
+	ht->count--;
+	migrateHashSlots(ht);
+	if (ht->current.capacity > HASH_TABLE_MIN_CAPACITY && (float)ht->count /
+		ht->current.capacity < HASH_SHRINK_LOAD_FACTOR)
+		resizeHashTable(ht, ht->current.capacity / 2);
+	return entry;
+}
+
+/**
+ * @brief Visita todas as entradas da tabela, por uma ordem qualquer.
+ * 
+ * @param ht A tabela.
+ * @param visit A função chamada para cada entrada.
+ */
+void hashTableForEach(HashTable *ht, void (*visit)(void *entry)) {
+	size_t i;
+	for (i = 0; i < ht->current.capacity; i++)
+		if (ht->current.slots[i].entry != NULL)
+			visit(ht->current.slots[i].entry);
+	for (i = 0; i < ht->previous.capacity; i++)
+		if (ht->previous.slots[i].entry != NULL)
+			visit(ht->previous.slots[i].entry);
+}
+
+/**
+ * @brief Libera os vetores de posições da tabela. As entradas pertencem a 
+ * quem as inseriu e não são liberadas.
+ * 
+ * @param ht A tabela.
+ */
+void destroyHashTable(HashTable *ht) {
+	freeHashSlots(&ht->current);
+	freeHashSlots(&ht->previous);
+	ht->count = 0;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file hashtable.h
+ * @author Diogo Lobo (ist1109293)
+ * @brief Cabeçalho da tabela de hash de endereçamento aberto usada pelos 
+ * lotes, pelas vacinas e pelos usuários. A tabela guarda ponteiros para as 
+ * entradas num único vetor de capacidade potência de dois, com o código de 
+ * hash de cada chave guardado ao lado, e resolve colisões por sondagem 
+ * linear Robin Hood: cada entrada fica a uma distância da sua posição ideal 
+ * nunca muito maior que a das vizinhas, o que mantém as sondagens curtas e 
+ * contíguas em memória mesmo com carga elevada. Os redimensionamentos são
+ * incrementais, para não parar um comando a recolocar a tabela inteira.
+ * @date 2026-10-16
+ */
+
+#ifndef HASHTABLE_H
+#define HASHTABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Capacidade mínima da tabela, potência de dois. */
+#define HASH_TABLE_MIN_CAPACITY 16
+
+/** Número máximo de posições migradas por cada inserção ou remoção durante
+ * um redimensionamento. */
+#define HASH_MIGRATE_STEP 8
+
+/** Carga abaixo da qual a tabela é reduzida a metade. */
+#define HASH_SHRINK_LOAD_FACTOR 0.125
+
+/** Função que devolve a chave (string) de uma entrada da tabela. */
+typedef const char* (*HashKeyFunction)(const void *entry);
+
+/** Estrutura que representa uma posição da tabela. */
+typedef struct HashSlot {
+    uint64_t hash; /** Código de hash completo da chave da entrada, usado
+    para a posição e para evitar comparar chaves diferentes. */
+    void *entry; /** Entrada guardada, ou NULL se a posição estiver livre. */
+} HashSlot;
+
+/** Estrutura que representa um vetor de posições da tabela. */
+typedef struct HashSlots {
+    HashSlot *slots; /** Vetor das posições. */
+    size_t capacity; /** Número de posições, sempre potência de dois. */
+    size_t count; /** Número de entradas guardadas neste vetor. */
+} HashSlots;
+
+/** Estrutura que representa uma tabela de hash de endereçamento aberto. 
+ * Ao mudar de capacidade, as entradas passam aos poucos do vetor anterior 
+ * para o atual, e as pesquisas consultam os dois até o fim da migração. */
+typedef struct HashTable {
+    HashSlots current; /** Vetor onde são feitas as inserções. */
+    HashSlots previous; /** Vetor anterior ao último redimensionamento, 
+    vazio quando não há migração em curso. */
+    size_t migrate_index; /** Próxima posição do vetor anterior a migrar. */
+    size_t count; /** Número total de entradas guardadas. */
+    HashKeyFunction key; /** Função que devolve a chave de cada entrada. */
+    uint64_t seed; /** Semente aleatória do código de hash, escolhida em 
+    cada processo, para que não se possam prever colisões. */
+} HashTable;
+
+uint64_t hashMix(uint64_t a, uint64_t b);
+
+uint64_t hashBytes(const void *data, size_t length, uint64_t seed);
+
+uint64_t hashString(const char *key, uint64_t seed);
+
+int initHashTable(HashTable *ht, HashKeyFunction key);
+
+void* hashTableFind(HashTable *ht, const char *key);
+
+int hashTableInsert(HashTable *ht, void *entry);
+
+void* hashTableRemove(HashTable *ht, const char *key);
+
+void hashTableForEach(HashTable *ht, void (*visit)(void *entry));
+
+void destroyHashTable(HashTable *ht);
+
+#endif
@@ -0,0 +1,307 @@
+/**
+ * @file import.c
+ * @author Diogo Lobo (ist1109293)
+ * @brief Implementação do modo de importação em massa.
+ * @date 2026-10-16
+ */
+
+/** Expõe clock_gettime, que é POSIX, mesmo quando se compila em C99 estrito. */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include "import.h"
+
+/**
+ * @brief Escolhe o número de threads de preparação: uma por processador 
+ * disponível, até IMPORT_MAX_THREADS.
+ * 
+ * @return O número de threads, incluindo a principal.
+ */
+int importThreadCount() {
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	if (count < 1) return 1;
+	if (count > IMPORT_MAX_THREADS) return IMPORT_MAX_THREADS;
+	return (int)count;
+}
+
+/**
+ * @brief Prepara a fatia da janela atual que cabe a uma thread. As fatias 
+ * são contíguas e de tamanho igual, a menos de uma linha.
+ * 
+ * @param worker A thread de preparação.
+ */
+void prepareImportSlice(ImportWorker *worker) {
+	ImportPool *pool = worker->pool;
+	long count = pool->line_count, threads = pool->thread_count;
+	int i, first, last;
+	first = (int)(count * worker->index / threads);
+	last = (int)(count * (worker->index + 1) / threads);
+	resetArena(&worker->arena);
+	for (i = first; i < last; i++)
+		if (!prepareCommand(&worker->arena, pool->lines[i].text, 
+			pool->lines[i].length, &pool->commands[i])) 
+			worker->failed = 1;
+}
+
+/**
+ * @brief Ciclo de uma thread de preparação: espera por cada nova janela, 
+ * prepara a sua fatia e avisa quando termina, até o conjunto ser parado.
+ * 
+ * @param arg A thread de preparação (ImportWorker).
+ * 
+ * @return NULL.
+ */
+void* importWorkerMain(void *arg) {
+	ImportWorker *worker = (ImportWorker*)arg;
+	ImportPool *pool = worker->pool;
+	unsigned long seen = 0;
+	pthread_mutex_lock(&pool->lock);
+	while (1) {
+		while (pool->generation == seen && !pool->stop)
+			pthread_cond_wait(&pool->work_ready, &pool->lock);
+		if (pool->stop) break;
+		seen = pool->generation;
+		pthread_mutex_unlock(&pool->lock);
+		prepareImportSlice(worker);
+		pthread_mutex_lock(&pool->lock);
+		if (--pool->pending == 0) pthread_cond_signal(&pool->work_done);
+	}
+	pthread_mutex_unlock(&pool->lock);
+	return NULL;
+}
+
+/**
+ * @brief Reserva os vetores da janela e as threads do conjunto, com as 
+ * respectivas arenas.
+ * 
+ * @param pool O conjunto a inicializar.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+int allocImportPool(ImportPool *pool) {
+	int i;
+	pool->thread_count = importThreadCount();
+	pool->lines = malloc(sizeof(InputLine) * IMPORT_WINDOW_LINES);
+	pool->commands = malloc(sizeof(Command) * IMPORT_WINDOW_LINES);
+	pool->workers = calloc(pool->thread_count, sizeof(ImportWorker));
+	if (!pool->lines || !pool->commands || !pool->workers) return 0;
+	for (i = 0; i < pool->thread_count; i++) {
+		pool->workers[i].pool = pool;
+		pool->workers[i].index = i;
+		if (!initArena(&pool->workers[i].arena, IMPORT_ARENA_SIZE)) 
+			return 0;
+	}
+	return 1;
+}
+
+/**
+ * @brief Inicializa o conjunto de threads de preparação. Se não for 
+ * possível criar todas as threads, o conjunto fica com as que foram 
+ * criadas, o que só reduz o paralelismo.
+ * 
+ * @param pool O conjunto a inicializar.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+int initImportPool(ImportPool *pool) {
+	int i;
+	pool->generation = 0;
+	pool->pending = pool->stop = pool->line_count = pool->running = 0;
+	pool->workers = NULL;
+	pool->lines = NULL;
+	pool->commands = NULL;
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->work_ready, NULL);
+	pthread_cond_init(&pool->work_done, NULL);
+	if (!allocImportPool(pool)) return 0;
+	for (i = 1; i < pool->thread_count; i++)
+		if (pthread_create(&pool->workers[i].thread, NULL, 
+			importWorkerMain, &pool->workers[i]) != 0) break;
+	pthread_mutex_lock(&pool->lock);
+	pool->thread_count = i;
+	pool->running = i - 1;
+	pthread_mutex_unlock(&pool->lock);
+	return 1;
+}
+
+/**
+ * @brief Para as threads do conjunto e libera os seus recursos.
+ * 
+ * @param pool O conjunto a destruir.
+ */
+void destroyImportPool(ImportPool *pool) {
+	int i;
+	pthread_mutex_lock(&pool->lock);
+	pool->stop = 1;
+	pthread_cond_broadcast(&pool->work_ready);
+	pthread_mutex_unlock(&pool->lock);
+	for (i = 1; i <= pool->running; i++)
+		pthread_join(pool->workers[i].thread, NULL);
+	for (i = 0; pool->workers && i < pool->thread_count; i++)
+		destroyArena(&pool->workers[i].arena);
+	pthread_mutex_destroy(&pool->lock);
+	pthread_cond_destroy(&pool->work_ready);
+	pthread_cond_destroy(&pool->work_done);
+	free(pool->workers);
+	free(pool->commands);
+	free(pool->lines);
+}
+
+/**
+ * @brief Prepara a janela atual em paralelo. A thread principal prepara a 
+ * primeira fatia e espera pelas restantes.
+ * 
+ * @param pool O conjunto de threads.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória numa das fatias.
+ */
+int prepareImportWindow(ImportPool *pool) {
+	int i;
+	pthread_mutex_lock(&pool->lock);
+	pool->pending = pool->thread_count - 1;
+	pool->generation++;
+	pthread_cond_broadcast(&pool->work_ready);
+	pthread_mutex_unlock(&pool->lock);
+	prepareImportSlice(&pool->workers[0]);
+	pthread_mutex_lock(&pool->lock);
+	while (pool->pending > 0)
+		pthread_cond_wait(&pool->work_done, &pool->lock);
+	pthread_mutex_unlock(&pool->lock);
+	for (i = 0; i < pool->thread_count; i++)
+		if (pool->workers[i].failed) return 0;
+	return 1;
+}
+
+/**
+ * @brief Lê as linhas da janela seguinte.
+ * 
+ * @param reader O leitor do arquivo, já todo carregado.
+ * @param pool O conjunto cujas linhas são preenchidas.
+ * 
+ * @return 1 se foram lidas linhas, 0 no fim do arquivo e -1 se faltar 
+ * memória.
+ */
+int readImportWindow(InputReader *reader, ImportPool *pool) {
+	int result = 1;
+	pool->line_count = 0;
+	while (pool->line_count < IMPORT_WINDOW_LINES && (result = 
+		readInputLine(reader, &pool->lines[pool->line_count])) == 1)
+		pool->line_count++;
+	if (result == -1) return -1;
+	return pool->line_count > 0;
+}
+
+/**
+ * @brief Aplica, por ordem, os comandos preparados da janela atual.
+ * 
+ * @param vaccinationSystem O sistema de vacinação.
+ * @param pool O conjunto com os comandos preparados.
+ * @param pt Indicador de linguagem.
+ * 
+ * @return O número de comandos aplicados, negativo se um deles foi `q`.
+ */
+int applyImportWindow(VaccinationSystem* vaccinationSystem, ImportPool *pool,
+	int pt) {
+	int i;
+	for (i = 0; i < pool->line_count; i++) {
+		resetArena(&vaccinationSystem->scratch);
+		if (!runCommand(vaccinationSystem, &pool->commands[i], pt)) 
+			return -(i + 1);
+	}
+	return pool->line_count;
+}
+
+/**
+ * @brief Soma a um acumulador o tempo decorrido desde um instante.
+ * 
+ * @param start O instante inicial.
+ * @param total O acumulador, em segundos.
+ */
+void addElapsed(const struct timespec *start, double *total) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	*total += (double)(now.tv_sec - start->tv_sec) + 
+		(double)(now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/**
+ * @brief Imprime no erro padrão o débito da importação, para não misturar 
+ * com a saída dos comandos.
+ * 
+ * @param count O número de comandos importados.
+ * @param parse O tempo de preparação, em segundos.
+ * @param apply O tempo de aplicação, em segundos.
+ * @param threads O número de threads de preparação.
+ */
+void reportImport(long count, double parse, double apply, int threads) {
+	double total = parse + apply;
+	fprintf(stderr, "import: %ld commands in %.3f s (%.0f commands/s); "
+		"parse %.3f s on %d threads, apply %.3f s\n", count, total, 
+		total > 0 ? count / total : 0.0, parse, threads, apply);
+}
+
+/**
+ * @brief Prepara e aplica todas as janelas do arquivo, até o fim ou ao 
+ * comando `q`.
+ * 
+ * @param vaccinationSystem O sistema de vacinação.
+ * @param reader O leitor do arquivo, já todo carregado.
+ * @param pool O conjunto de threads de preparação.
+ * @param pt Indicador de linguagem.
+ * 
+ * @return 1 em caso de sucesso, -1 se faltar memória.
+ */
+int runImport(VaccinationSystem* vaccinationSystem, InputReader *reader, 
+	ImportPool *pool, int pt) {
+	struct timespec start;
+	double parse = 0, apply = 0;
+	long count = 0;
+	int applied = 0, result = 1;
+	while (applied >= 0 && 
+		(result = readImportWindow(reader, pool)) == 1) {
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		if (!prepareImportWindow(pool)) return -1;
+		addElapsed(&start, &parse);
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		applied = applyImportWindow(vaccinationSystem, pool, pt);
+		addElapsed(&start, &apply);
+		count += applied >= 0 ? applied : -applied;
+	}
+	if (result == -1) return -1;
+	flushOutput(&vaccinationSystem->output);
+	reportImport(count, parse, apply, pool->thread_count);
+	return 1;
+}
+
+/**
+ * @brief Importa os comandos de um arquivo, preparando-os em paralelo e 
+ * aplicando-os por ordem, com o mesmo resultado da leitura sequencial.
+ * 
+ * @param vaccinationSystem O sistema de vacinação.
+ * @param path O caminho do arquivo.
+ * @param pt Indicador de linguagem.
+ * 
+ * @return 1 em caso de sucesso, 0 se o arquivo não puder ser aberto ou lido
+ * e -1 se faltar memória.
+ */
+int importCommands(VaccinationSystem* vaccinationSystem, const char* path, 
+	int pt) {
+	InputReader reader;
+	ImportPool pool;
+	int fd, result = -1;
+	fd = open(path, O_RDONLY);
+	if (fd < 0) return 0;
+	if (initInputReader(&reader, fd, NULL) && loadWholeInput(&reader) && 
+		!reader.failed) {
+		if (initImportPool(&pool))
+			result = runImport(vaccinationSystem, &reader, &pool, 
+				pt);
+		destroyImportPool(&pool);
+	} else if (reader.failed) result = 0;
+	destroyInputReader(&reader);
+	close(fd);
+	return result;
+}
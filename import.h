@@ -0,0 +1,60 @@
+/**
+ * @file import.h
+ * @author Diogo Lobo (ist1109293)
+ * @brief Cabeçalho do modo de importação em massa. As linhas de um arquivo 
+ * são lidas em janelas; cada janela é preparada em paralelo por um conjunto 
+ * de threads e depois aplicada, por ordem, por uma única thread, pelo que o 
+ * resultado é igual ao da execução sequencial.
+ * @date 2026-10-16
+ */
+
+#ifndef IMPORT_H
+#define IMPORT_H
+
+#include <pthread.h>
+#include "arena.h"
+#include "commands.h"
+#include "input.h"
+#include "system.h"
+
+/** Número de linhas preparadas em paralelo de cada vez. */
+#define IMPORT_WINDOW_LINES 65536
+
+/** Número máximo de threads usadas na preparação. */
+#define IMPORT_MAX_THREADS 64
+
+/** Capacidade inicial da arena de cada thread. */
+#define IMPORT_ARENA_SIZE (1 << 20)
+
+struct ImportPool;
+
+/** Estrutura que representa uma thread de preparação. */
+typedef struct ImportWorker {
+    pthread_t thread; /** Thread do sistema, exceto na thread principal. */
+    struct ImportPool *pool; /** Conjunto a que a thread pertence. */
+    Arena arena; /** Arena dos argumentos dos comandos da sua fatia. */
+    int index; /** Posição da thread, que define a sua fatia da janela. */
+    int failed; /** 1 se faltou memória ao preparar a fatia. */
+} ImportWorker;
+
+/** Estrutura que representa o conjunto de threads de preparação. A thread
+ * principal é a de índice 0. */
+typedef struct ImportPool {
+    ImportWorker *workers; /** Threads do conjunto. */
+    int thread_count; /** Número de threads, incluindo a principal. */
+    int running; /** Número de threads criadas, além da principal. */
+    pthread_mutex_t lock; /** Protege os campos de sincronização. */
+    pthread_cond_t work_ready; /** Sinaliza uma nova janela ou o fim. */
+    pthread_cond_t work_done; /** Sinaliza que a última fatia terminou. */
+    unsigned long generation; /** Número da janela atual. */
+    int pending; /** Threads que ainda não terminaram a sua fatia. */
+    int stop; /** 1 quando as threads devem terminar. */
+    InputLine *lines; /** Linhas da janela atual. */
+    Command *commands; /** Comandos preparados da janela atual. */
+    int line_count; /** Número de linhas da janela atual. */
+} ImportPool;
+
+int importCommands(VaccinationSystem* vaccinationSystem, const char* path, 
+int pt);
+
+#endif
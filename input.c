@@ -0,0 +1,188 @@
+/**
+ * @file input.c
+ * @author Diogo Lobo (ist1109293)
+ * @brief Implementação do leitor de entrada por blocos.
+ * @date 2026-10-16
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "input.h"
+
+/**
+ * @brief Tenta projetar em memória a entrada, quando esta é um arquivo
+ * regular não vazio. A projeção é privada, pelo que as linhas podem ser 
+ * terminadas no lugar sem alterar o arquivo.
+ * 
+ * @param reader O leitor.
+ * 
+ * @return 1 se a entrada ficou projetada, 0 caso contrário.
+ */
+int mapInput(InputReader *reader) {
+	struct stat info;
+	void *data;
+	if (fstat(reader->fd, &info) != 0 || !S_ISREG(info.st_mode) || 
+		info.st_size <= 0) return 0;
+	data = mmap(NULL, (size_t)info.st_size, PROT_READ | PROT_WRITE, 
+		MAP_PRIVATE, reader->fd, 0);
+	if (data == MAP_FAILED) return 0;
+	reader->data = (char*)data;
+	reader->end = (size_t)info.st_size;
+	reader->mapped = 1;
+	reader->eof = 1;
+	return 1;
+}
+
+/**
+ * @brief Inicializa um leitor de entrada sobre um descritor.
+ * 
+ * @param reader O leitor a inicializar.
+ * @param fd O descritor de onde a entrada é lida.
+ * @param out A saída a escrever antes de cada leitura bloqueante.
+ * 
+ * @return 1 em caso de sucesso, 0 se a alocação do buffer falhar.
+ */
+int initInputReader(InputReader *reader, int fd, Output *out) {
+	reader->fd = fd;
+	reader->start = reader->end = 0;
+	reader->capacity = 0;
+	reader->tail = NULL;
+	reader->mapped = reader->eof = reader->failed = 0;
+	reader->out = out;
+	if (mapInput(reader)) return 1;
+	reader->data = (char*)malloc(INPUT_BLOCK_SIZE);
+	if (reader->data == NULL) return 0;
+	reader->capacity = INPUT_BLOCK_SIZE;
+	return 1;
+}
+
+/**
+ * @brief Lê mais um bloco da entrada para o buffer. Os dados ainda não
+ * consumidos são movidos para o início e o buffer é duplicado se uma linha
+ * não couber nele. As leituras interrompidas por um sinal são repetidas; 
+ * outro erro termina a entrada e fica assinalado no leitor.
+ * 
+ * @param reader O leitor.
+ * 
+ * @return 1 em caso de sucesso, 0 se a alocação falhar.
+ */
+int fillInputBuffer(InputReader *reader) {
+	ssize_t count;
+	char *data;
+	memmove(reader->data, reader->data + reader->start, 
+		reader->end - reader->start);
+	reader->end -= reader->start;
+	reader->start = 0;
+	if (reader->end + 1 >= reader->capacity) {
+		data = (char*)realloc(reader->data, reader->capacity * 2);
+		if (data == NULL) return 0;
+		reader->data = data;
+		reader->capacity *= 2;
+	}
+	if (reader->out != NULL) flushOutput(reader->out);
+	do count = read(reader->fd, reader->data + reader->end, 
+		reader->capacity - reader->end - 1);
+	while (count < 0 && errno == EINTR);
+	if (count < 0) reader->failed = 1;
+	if (count <= 0) reader->eof = 1;
+	else reader->end += (size_t)count;
+	return 1;
+}
+
+/**
+ * @brief Indica se a linha seguinte pode ser entregue sem uma leitura 
+ * bloqueante.
+ * 
+ * @param reader O leitor.
+ * 
+ * @return 1 se a linha seguinte já está disponível ou a entrada acabou, 0 
+ * se é preciso esperar por mais entrada.
+ */
+int inputLineReady(InputReader *reader) {
+	return reader->eof || memchr(reader->data + reader->start, '\n', 
+		reader->end - reader->start) != NULL;
+}
+
+/**
+ * @brief Entrega a última linha de uma entrada projetada que não termina em
+ * '\n', copiando-a para poder ser terminada em '\0'.
+ * 
+ * @param reader O leitor.
+ * @param line A linha a preencher.
+ * 
+ * @return 1 em caso de sucesso, 0 se a alocação falhar.
+ */
+int mappedTailLine(InputReader *reader, InputLine *line) {
+	line->length = reader->end - reader->start;
+	reader->tail = (char*)malloc(line->length + 1);
+	if (reader->tail == NULL) return 0;
+	memcpy(reader->tail, reader->data + reader->start, line->length);
+	reader->tail[line->length] = '\0';
+	line->text = reader->tail;
+	reader->start = reader->end;
+	return 1;
+}
+
+/**
+ * @brief Lê a próxima linha da entrada. A linha aponta para o buffer do
+ * leitor e só é válida até a leitura seguinte. Se a leitura tiver falhado, 
+ * a linha incompleta que sobra no buffer é descartada.
+ * 
+ * @param reader O leitor.
+ * @param line A linha a preencher.
+ * 
+ * @return 1 se foi lida uma linha, 0 no fim da entrada e -1 se faltar 
+ * memória.
+ */
+int readInputLine(InputReader *reader, InputLine *line) {
+	char *newline;
+	while (1) {
+		newline = memchr(reader->data + reader->start, '\n', 
+			reader->end - reader->start);
+		if (newline != NULL || (reader->eof && !reader->failed && 
+			reader->start < reader->end)) break;
+		if (reader->eof) return 0;
+		if (!fillInputBuffer(reader)) return -1;
+	}
+	if (newline == NULL) {
+		if (reader->mapped) 
+			return mappedTailLine(reader, line) ? 1 : -1;
+		newline = reader->data + reader->end;
+	}
+	line->text = reader->data + reader->start;
+	line->length = (size_t)(newline - line->text);
+	*newline = '\0';
+	reader->start += line->length + 1;
+	if (reader->start > reader->end) reader->start = reader->end;
+	return 1;
+}
+
+/**
+ * @brief Lê toda a entrada restante para o buffer, de forma que as linhas 
+ * lidas a seguir continuem válidas até o leitor ser destruído. Uma entrada 
+ * projetada em memória já está toda disponível.
+ * 
+ * @param reader O leitor.
+ * 
+ * @return 1 em caso de sucesso, 0 se a alocação falhar.
+ */
+int loadWholeInput(InputReader *reader) {
+	while (!reader->eof)
+		if (!fillInputBuffer(reader)) return 0;
+	return 1;
+}
+
+/**
+ * @brief Libera os recursos do leitor.
+ * 
+ * @param reader O leitor a destruir.
+ */
+void destroyInputReader(InputReader *reader) {
+	if (reader->mapped) munmap(reader->data, reader->end);
+	else free(reader->data);
+	free(reader->tail);
+}
@@ -0,0 +1,53 @@
+/**
+ * @file input.h
+ * @author Diogo Lobo (ist1109293)
+ * @brief Cabeçalho do leitor de entrada por blocos. A entrada é lida em
+ * blocos grandes com read(2), ou projetada em memória com mmap(2) quando é
+ * um arquivo regular, e dividida em linhas no próprio buffer, sem cópias nem
+ * alocações por linha.
+ * @date 2026-10-16
+ */
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stddef.h>
+#include "output.h"
+
+/** Capacidade inicial, em bytes, do buffer de leitura. */
+#define INPUT_BLOCK_SIZE (1 << 20)
+
+/** Estrutura que representa uma linha da entrada, terminada em '\0' no
+ * lugar do '\n' original. */
+typedef struct InputLine {
+    char *text; /** Início da linha. */
+    size_t length; /** Comprimento da linha, sem o '\n'. */
+} InputLine;
+
+/** Estrutura que representa o leitor de entrada. */
+typedef struct InputReader {
+    int fd; /** Descritor de onde a entrada é lida. */
+    char *data; /** Início da entrada projetada ou do buffer de leitura. */
+    size_t start; /** Posição da próxima linha por consumir. */
+    size_t end; /** Fim dos dados disponíveis. */
+    size_t capacity; /** Capacidade do buffer de leitura. */
+    char *tail; /** Cópia da última linha de uma entrada projetada quando
+    esta não termina em '\n'. */
+    int mapped; /** 1 se a entrada está projetada em memória. */
+    int eof; /** 1 se já foi atingido o fim da entrada. */
+    int failed; /** 1 se a leitura falhou antes do fim da entrada. */
+    Output *out; /** Saída escrita antes de cada leitura bloqueante, para
+    que as respostas cheguem antes de se esperar pelo comando seguinte. */
+} InputReader;
+
+int initInputReader(InputReader *reader, int fd, Output *out);
+
+int readInputLine(InputReader *reader, InputLine *line);
+
+int inputLineReady(InputReader *reader);
+
+int loadWholeInput(InputReader *reader);
+
+void destroyInputReader(InputReader *reader);
+
+#endif
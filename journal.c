@@ -0,0 +1,654 @@
+/**
+ * @file journal.c
+ * @author Diogo Lobo (ist1109293)
+ * @brief Implementação do diário das mutações do sistema de vacinação. Cada 
+ * comando que muda o estado é acrescentado ao diário numa codificação 
+ * binária; as entradas são escritas e sincronizadas com o disco em grupos 
+ * e, no arranque, reaplicadas diretamente às estruturas, sem passar pelos 
+ * comandos nem produzir saída.
+ * @date 2026-10-16
+ */
+/** Expõe fdatasync e ftruncate, que são POSIX, em C99 estrito. */
+#define _POSIX_C_SOURCE 200809L
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "hashtable.h"
+#include "system.h"
+#include "journal.h"
+#include "utils.h"
+
+/** Tamanho do enquadramento de cada entrada: tamanho e código de 
+ * verificação do conteúdo. */
+#define JOURNAL_FRAME_SIZE 8
+
+/**
+ * @brief Inicializa um diário desativado, que só conta as mutações.
+ * 
+ * @param journal O diário.
+ */
+void initJournal(Journal *journal) {
+	journal->fd = -1;
+	journal->buffer = NULL;
+	journal->used = journal->capacity = journal->start = 0;
+	journal->pending = 0;
+	journal->group_size = JOURNAL_GROUP_SIZE;
+	journal->failed = 0;
+	journal->next_lsn = 0;
+}
+
+/**
+ * @brief Garante que o buffer do diário tem espaço para mais bytes.
+ * 
+ * @param journal O diário.
+ * @param size O número de bytes a acrescentar.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+int reserveJournal(Journal *journal, size_t size) {
+	size_t capacity = journal->capacity;
+	unsigned char *buffer;
+	if (journal->used + size <= capacity) return 1;
+	if (capacity < JOURNAL_BUFFER_SIZE) capacity = JOURNAL_BUFFER_SIZE;
+	while (capacity < journal->used + size) capacity *= 2;
+	buffer = (unsigned char*)realloc(journal->buffer, capacity);
+	if (buffer == NULL) {
+		journal->failed = 1;
+		return 0;
+	}
+	journal->buffer = buffer;
+	journal->capacity = capacity;
+	return 1;
+}
+
+/**
+ * @brief Acrescenta um número sem sinal à entrada em construção, em 7 bits 
+ * por byte, para que os números pequenos ocupem um só byte.
+ * 
+ * @param journal O diário.
+ * @param value O número.
+ */
+void putJournalNumber(Journal *journal, uint64_t value) {
+	unsigned char *bytes;
+	if (!reserveJournal(journal, 10)) return;
+	bytes = journal->buffer + journal->used;
+	while (value >= 0x80) {
+		*bytes++ = (unsigned char)(value | 0x80);
+		value >>= 7;
+	}
+	*bytes++ = (unsigned char)value;
+	journal->used = (size_t)(bytes - journal->buffer);
+}
+
+/**
+ * @brief Acrescenta uma string à entrada em construção: o tamanho, o texto e 
+ * o '\0', para que a string possa ser usada diretamente na leitura.
+ * 
+ * @param journal O diário.
+ * @param text A string.
+ */
+void putJournalString(Journal *journal, const char *text) {
+	size_t length = strlen(text);
+	putJournalNumber(journal, length);
+	if (!reserveJournal(journal, length + 1)) return;
+	memcpy(journal->buffer + journal->used, text, length + 1);
+	journal->used += length + 1;
+}
+
+/**
+ * @brief Começa uma entrada do diário, reservando o enquadramento.
+ * 
+ * @param journal O diário.
+ * @param type O tipo da entrada.
+ */
+void beginJournalEntry(Journal *journal, unsigned char type) {
+	journal->start = journal->used;
+	if (!reserveJournal(journal, JOURNAL_FRAME_SIZE + 1)) return;
+	journal->used += JOURNAL_FRAME_SIZE;
+	journal->buffer[journal->used++] = type;
+}
+
+/**
+ * @brief Escreve todos os bytes no arquivo do diário, repetindo as escritas 
+ * parciais e as interrompidas por um sinal.
+ * 
+ * @param fd O descritor do arquivo.
+ * @param data Os bytes a escrever.
+ * @param size O número de bytes.
+ * 
+ * @return 1 em caso de sucesso, 0 se a escrita falhar.
+ */
+int writeJournalBytes(int fd, const unsigned char *data, size_t size) {
+	ssize_t written;
+	while (size > 0) {
+		written = write(fd, data, size);
+		if (written < 0 && errno == EINTR) continue;
+		if (written <= 0) return 0;
+		data += written;
+		size -= (size_t)written;
+	}
+	return 1;
+}
+
+/**
+ * @brief Escreve no arquivo as entradas do buffer, sem sincronizar.
+ * 
+ * @param journal O diário.
+ * 
+ * @return 1 em caso de sucesso, 0 se a escrita falhar.
+ */
+int flushJournal(Journal *journal) {
+	int result = writeJournalBytes(journal->fd, journal->buffer, 
+		journal->used);
+	journal->used = journal->start = 0;
+	return result;
+}
+
+/**
+ * @brief Escreve no arquivo as entradas pendentes e sincroniza-as com o 
+ * disco, confirmando de uma só vez todas as mutações do grupo.
+ * 
+ * @param journal O diário.
+ * 
+ * @return 1 em caso de sucesso, 0 se a escrita falhar.
+ */
+int syncJournal(Journal *journal) {
+	if (journal->fd < 0 || journal->pending == 0) return 1;
+	journal->pending = 0;
+	return flushJournal(journal) && fdatasync(journal->fd) == 0;
+}
+
+/**
+ * @brief Conclui a entrada em construção, preenchendo o enquadramento, e 
+ * sincroniza o grupo quando fica completo.
+ * 
+ * @param journal O diário.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória ou a escrita falhar.
+ */
+int endJournalEntry(Journal *journal) {
+	unsigned char *frame = journal->buffer + journal->start;
+	uint32_t length, checksum;
+	if (journal->failed) {
+		journal->used = journal->start;
+		return 0;
+	}
+	length = (uint32_t)(journal->used - journal->start - 
+		JOURNAL_FRAME_SIZE);
+	checksum = (uint32_t)hashBytes(frame + JOURNAL_FRAME_SIZE, length, 
+		JOURNAL_CHECKSUM_SEED);
+	memcpy(frame, &length, sizeof(length));
+	memcpy(frame + sizeof(length), &checksum, sizeof(checksum));
+	journal->next_lsn++;
+	journal->pending++;
+	if (journal->group_size > 0 && journal->pending >= journal->group_size)
+		return syncJournal(journal);
+	if (journal->used >= JOURNAL_BUFFER_SIZE) return flushJournal(journal);
+	return 1;
+}
+
+/**
+ * @brief Conta uma mutação num diário desativado.
+ * 
+ * @param journal O diário.
+ * 
+ * @return Sempre 1.
+ */
+int skipJournalEntry(Journal *journal) {
+	journal->next_lsn++;
+	return 1;
+}
+
+/**
+ * @brief Acrescenta ao diário a criação de um lote.
+ * 
+ * @param journal O diário.
+ * @param batch_id O ID do lote.
+ * @param date A data de validade do lote.
+ * @param doses O número de doses do lote.
+ * @param vaccine_name O nome da vacina do lote.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória ou a escrita falhar.
+ */
+int journalCreateBatch(Journal *journal, const char *batch_id, Date date, 
+	int doses, const char *vaccine_name) {
+	if (journal->fd < 0) return skipJournalEntry(journal);
+	beginJournalEntry(journal, JOURNAL_CREATE);
+	putJournalString(journal, batch_id);
+	putJournalNumber(journal, date);
+	putJournalNumber(journal, (uint64_t)doses);
+	putJournalString(journal, vaccine_name);
+	return endJournalEntry(journal);
+}
+
+/**
+ * @brief Acrescenta ao diário a aplicação de uma dose, na data atual.
+ * 
+ * @param journal O diário.
+ * @param user_name O nome do usuário vacinado.
+ * @param batch_id O ID do lote de onde saiu a dose.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória ou a escrita falhar.
+ */
+int journalApplyDose(Journal *journal, const char *user_name, 
+	const char *batch_id) {
+	if (journal->fd < 0) return skipJournalEntry(journal);
+	beginJournalEntry(journal, JOURNAL_APPLY);
+	putJournalString(journal, user_name);
+	putJournalString(journal, batch_id);
+	return endJournalEntry(journal);
+}
+
+/**
+ * @brief Acrescenta ao diário a retirada de um lote.
+ * 
+ * @param journal O diário.
+ * @param batch_id O ID do lote.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória ou a escrita falhar.
+ */
+int journalRemoveBatch(Journal *journal, const char *batch_id) {
+	if (journal->fd < 0) return skipJournalEntry(journal);
+	beginJournalEntry(journal, JOURNAL_REMOVE);
+	putJournalString(journal, batch_id);
+	return endJournalEntry(journal);
+}
+
+/**
+ * @brief Acrescenta ao diário a remoção de registros de vacinação.
+ * 
+ * @param journal O diário.
+ * @param user_name O nome do usuário.
+ * @param flags JOURNAL_DELETE_DATE e JOURNAL_DELETE_BATCH, conforme a 
+ * remoção é limitada a uma data e a um lote.
+ * @param date A data da vacinação, se JOURNAL_DELETE_DATE.
+ * @param batch_id O ID do lote, se JOURNAL_DELETE_BATCH.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória ou a escrita falhar.
+ */
+int journalDeleteRecords(Journal *journal, const char *user_name, 
+	int flags, Date date, const char *batch_id) {
+	if (journal->fd < 0) return skipJournalEntry(journal);
+	beginJournalEntry(journal, JOURNAL_DELETE);
+	putJournalNumber(journal, (uint64_t)flags);
+	putJournalString(journal, user_name);
+	if (flags & JOURNAL_DELETE_DATE) putJournalNumber(journal, date);
+	if (flags & JOURNAL_DELETE_BATCH) putJournalString(journal, batch_id);
+	return endJournalEntry(journal);
+}
+
+/**
+ * @brief Acrescenta ao diário o avanço da data atual.
+ * 
+ * @param journal O diário.
+ * @param date A nova data.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória ou a escrita falhar.
+ */
+int journalPassTime(Journal *journal, Date date) {
+	if (journal->fd < 0) return skipJournalEntry(journal);
+	beginJournalEntry(journal, JOURNAL_TIME);
+	putJournalNumber(journal, date);
+	return endJournalEntry(journal);
+}
+
+/**
+ * @brief Escreve o cabeçalho do diário e descarta todas as entradas, que 
+ * passam a estar contidas num snapshot. As mutações seguintes começam na 
+ * próxima mutação do diário. Só deve ser chamada depois de o snapshot e o 
+ * seu diretório estarem sincronizados com o disco.
+ * 
+ * @param journal O diário.
+ * 
+ * @return 1 em caso de sucesso, 0 se a escrita falhar.
+ */
+int checkpointJournal(Journal *journal) {
+	JournalHeader header;
+	if (journal->fd < 0) return 1;
+	journal->used = journal->start = 0;
+	journal->pending = 0;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+	header.version = JOURNAL_VERSION;
+	header.byte_order = JOURNAL_BYTE_ORDER;
+	header.base_lsn = journal->next_lsn;
+	return ftruncate(journal->fd, 0) == 0 && 
+		lseek(journal->fd, 0, SEEK_SET) == 0 && 
+		writeJournalBytes(journal->fd, (const unsigned char*)&header, 
+		sizeof(header)) && fdatasync(journal->fd) == 0;
+}
+
+/**
+ * @brief Sincroniza as entradas pendentes e fecha o diário.
+ * 
+ * @param journal O diário.
+ * 
+ * @return 1 em caso de sucesso, 0 se a escrita falhar.
+ */
+int closeJournal(Journal *journal) {
+	int result = 1;
+	if (journal->fd >= 0) {
+		result = syncJournal(journal);
+		if (close(journal->fd) != 0) result = 0;
+		journal->fd = -1;
+	}
+	free(journal->buffer);
+	journal->buffer = NULL;
+	journal->used = journal->capacity = journal->start = 0;
+	return result;
+}
+
+/** Estrutura que representa a leitura do conteúdo de uma entrada. */
+typedef struct JournalReader {
+    const unsigned char *cursor; /** Próximo byte a ler. */
+    const unsigned char *end; /** Fim do conteúdo da entrada. */
+    int valid; /** 0 se a leitura passou do fim ou encontrou um valor 
+    inválido. */
+} JournalReader;
+
+/**
+ * @brief Lê um número sem sinal de uma entrada.
+ * 
+ * @param reader A leitura da entrada.
+ * 
+ * @return O número, ou 0 se a entrada for inválida.
+ */
+uint64_t readJournalNumber(JournalReader *reader) {
+	uint64_t value = 0;
+	int shift;
+	for (shift = 0; shift < 64 && reader->cursor < reader->end;
+		shift += 7) {
+		value |= (uint64_t)(*reader->cursor & 0x7f) << shift;
+		if ((*reader->cursor++ & 0x80) == 0) return value;
+	}
+	reader->valid = 0;
+	return 0;
+}
+
+/**
+ * @brief Lê uma string de uma entrada, sem a copiar.
+ * 
+ * @param reader A leitura da entrada.
+ * 
+ * @return A string, terminada em '\0', ou "" se a entrada for inválida.
+ */
+const char* readJournalString(JournalReader *reader) {
+	uint64_t length = readJournalNumber(reader);
+	const char *text = (const char*)reader->cursor;
+	if (!reader->valid || 
+		length >= (uint64_t)(reader->end - reader->cursor) || 
+		reader->cursor[length] != '\0') {
+		reader->valid = 0;
+		return "";
+	}
+	reader->cursor += length + 1;
+	return text;
+}
+
+/**
+ * @brief Reaplica a criação de um lote.
+ * 
+ * @param vs O sistema de vacinação.
+ * @param reader A leitura da entrada.
+ * 
+ * @return 1 em caso de sucesso, 0 se a entrada não corresponder ao estado e 
+ * -1 se faltar memória.
+ */
+int replayCreateBatch(VaccinationSystem *vs, JournalReader *reader) {
+	const char *batch_id = readJournalString(reader);
+	Date date = (Date)readJournalNumber(reader);
+	int doses = (int)readJournalNumber(reader);
+	const char *vaccine_name = readJournalString(reader);
+	if (!reader->valid || !validBatchId(batch_id) || 
+		searchBatchInSystem(vs->batches_ht, batch_id) != NULL) return 0;
+	return insertBatchInSystem(vs->batches_ht, batch_id, date, doses, 
+		vaccine_name) ? 1 : -1;
+}
+
+/**
+ * @brief Reaplica a aplicação de uma dose, na data atual.
+ * 
+ * @param vs O sistema de vacinação.
+ * @param reader A leitura da entrada.
+ * 
+ * @return 1 em caso de sucesso, 0 se a entrada não corresponder ao estado e 
+ * -1 se faltar memória.
+ */
+int replayApplyDose(VaccinationSystem *vs, JournalReader *reader) {
+	const char *user_name = readJournalString(reader);
+	const char *batch_id = readJournalString(reader);
+	BatchInfo *batch;
+	int result;
+	if (!reader->valid || 
+		(batch = searchBatchInSystem(vs->batches_ht, batch_id)) == NULL)
+		return 0;
+	result = insertUserRecord(vs, user_name, batch, vs->current_date);
+	if (result != 1) return result == 0 ? -1 : 0;
+	applyDoseFromBatch(vs->batches_ht, batch);
+	return 1;
+}
+
+/**
+ * @brief Reaplica a retirada de um lote.
+ * 
+ * @param vs O sistema de vacinação.
+ * @param reader A leitura da entrada.
+ * 
+ * @return 1 em caso de sucesso, 0 se a entrada não corresponder ao estado e 
+ * -1 se faltar memória.
+ */
+int replayRemoveBatch(VaccinationSystem *vs, JournalReader *reader) {
+	const char *batch_id = readJournalString(reader);
+	BatchInfo *batch;
+	if (!reader->valid || 
+		(batch = searchBatchInSystem(vs->batches_ht, batch_id)) == NULL)
+		return 0;
+	return retireBatchFromSystem(vs->batches_ht, batch) ? 1 : -1;
+}
+
+/**
+ * @brief Reaplica a remoção de registros de vacinação.
+ * 
+ * @param vs O sistema de vacinação.
+ * @param reader A leitura da entrada.
+ * 
+ * @return 1 em caso de sucesso, 0 se a entrada não corresponder ao estado e 
+ * -1 se faltar memória.
+ */
+int replayDeleteRecords(VaccinationSystem *vs, JournalReader *reader) {
+	int flags = (int)readJournalNumber(reader);
+	const char *user_name = readJournalString(reader);
+	Date date = 0;
+	const char *batch_id = NULL;
+	VaccinationRecordsHashtable *records;
+	int deleted;
+	if (flags & JOURNAL_DELETE_DATE) date = (Date)readJournalNumber(reader);
+	if (flags & JOURNAL_DELETE_BATCH) batch_id = readJournalString(reader);
+	if (!reader->valid) return 0;
+	records = userRecords(vs, user_name);
+	if (!userExistInSystem(records, user_name)) return 0;
+	if (batch_id != NULL)
+		deleted = deleteRecordByNameDateAndBatchID(records, user_name, 
+			date, batch_id);
+	else if (flags & JOURNAL_DELETE_DATE)
+		deleted = deleteRecordByNameAndDate(records, user_name, date);
+	else deleted = deleteRecordVaccinationRecordsUser(records, user_name);
+	return deleted == RECORD_NO_MEMORY ? -1 : 1;
+}
+
+/**
+ * @brief Reaplica uma entrada do diário ao sistema de vacinação.
+ * 
+ * @param vs O sistema de vacinação.
+ * @param data O conteúdo da entrada.
+ * @param length O tamanho do conteúdo.
+ * 
+ * @return 1 em caso de sucesso, 0 se a entrada não corresponder ao estado e 
+ * -1 se faltar memória.
+ */
+int replayJournalEntry(VaccinationSystem *vs, const unsigned char *data, 
+	uint32_t length) {
+	JournalReader reader;
+	int result = 0;
+	if (length == 0) return 0;
+	reader.cursor = data + 1;
+	reader.end = data + length;
+	reader.valid = 1;
+	switch (data[0]) {
+		case JOURNAL_CREATE: 
+			result = replayCreateBatch(vs, &reader);
+			break;
+		case JOURNAL_APPLY: 
+			result = replayApplyDose(vs, &reader);
+			break;
+		case JOURNAL_REMOVE: 
+			result = replayRemoveBatch(vs, &reader);
+			break;
+		case JOURNAL_DELETE: 
+			result = replayDeleteRecords(vs, &reader);
+			break;
+		case JOURNAL_TIME: 
+			setSystemDate(vs, (Date)readJournalNumber(&reader));
+			result = reader.valid;
+			break;
+		default: break;
+	}
+	return result == 1 && reader.cursor != reader.end ? 0 : result;
+}
+
+/**
+ * @brief Verifica o cabeçalho de um diário.
+ * 
+ * @param data O conteúdo do arquivo.
+ * @param size O tamanho do arquivo.
+ * 
+ * @return 1 se o cabeçalho for válido, 0 caso contrário.
+ */
+int validJournalHeader(const unsigned char *data, uint64_t size) {
+	const JournalHeader *header = (const JournalHeader*)data;
+	return size >= sizeof(JournalHeader) && 
+		memcmp(header->magic, JOURNAL_MAGIC, 
+			sizeof(header->magic)) == 0 && 
+		header->version == JOURNAL_VERSION && 
+		header->byte_order == JOURNAL_BYTE_ORDER;
+}
+
+/**
+ * @brief Lê o enquadramento da entrada numa posição do diário.
+ * 
+ * @param data O conteúdo do arquivo.
+ * @param size O tamanho do arquivo.
+ * @param offset A posição da entrada.
+ * @param length Onde guardar o tamanho do conteúdo da entrada.
+ * 
+ * @return 1 se a entrada estiver completa e o código de verificação 
+ * corresponder ao conteúdo, 0 caso contrário.
+ */
+int readJournalFrame(const unsigned char *data, uint64_t size, 
+	uint64_t offset, uint32_t *length) {
+	const unsigned char *frame = data + offset;
+	uint32_t checksum;
+	if (size - offset < JOURNAL_FRAME_SIZE) return 0;
+	memcpy(length, frame, sizeof(*length));
+	memcpy(&checksum, frame + sizeof(*length), sizeof(checksum));
+	return *length <= size - offset - JOURNAL_FRAME_SIZE && 
+		checksum == (uint32_t)hashBytes(frame + JOURNAL_FRAME_SIZE, 
+		*length, JOURNAL_CHECKSUM_SEED);
+}
+
+/**
+ * @brief Reaplica as entradas de um diário posteriores ao estado atual. A 
+ * leitura pára na primeira entrada incompleta ou com o código de 
+ * verificação errado, que é uma escrita interrompida.
+ * 
+ * @param vs O sistema de vacinação.
+ * @param data O conteúdo do arquivo.
+ * @param size O tamanho do arquivo.
+ * @param end Onde guardar o fim da última entrada válida.
+ * 
+ * @return 1 em caso de sucesso, 0 se o diário não corresponder ao estado e 
+ * -1 se faltar memória.
+ */
+int replayJournal(VaccinationSystem *vs, const unsigned char *data, 
+	uint64_t size, uint64_t *end) {
+	uint64_t offset = sizeof(JournalHeader);
+	uint64_t lsn = ((const JournalHeader*)data)->base_lsn;
+	uint32_t length;
+	int result;
+	if (lsn > vs->journal.next_lsn) return 0;
+	while (readJournalFrame(data, size, offset, &length)) {
+		if (lsn >= vs->journal.next_lsn) {
+			result = replayJournalEntry(vs, 
+				data + offset + JOURNAL_FRAME_SIZE, length);
+			if (result != 1) return result;
+		}
+		offset += JOURNAL_FRAME_SIZE + length;
+		lsn++;
+	}
+	*end = offset;
+	if (lsn > vs->journal.next_lsn) vs->journal.next_lsn = lsn;
+	else if (lsn < vs->journal.next_lsn) *end = 0;
+	return 1;
+}
+
+/**
+ * @brief Reaplica um diário existente e prepara-o para novas entradas, 
+ * descartando uma escrita interrompida no fim. Um diário que termina antes 
+ * do estado atual é recomeçado a partir dele.
+ * 
+ * @param vs O sistema de vacinação.
+ * @param size O tamanho do arquivo.
+ * 
+ * @return 1 em caso de sucesso, 0 se o diário for inválido ou não 
+ * corresponder ao estado e -1 se faltar memória.
+ */
+int recoverJournal(VaccinationSystem *vs, uint64_t size) {
+	Journal *journal = &vs->journal;
+	uint64_t end = 0;
+	void *data;
+	int result = 0;
+	data = mmap(NULL, (size_t)size, PROT_READ, MAP_PRIVATE, journal->fd, 0);
+	if (data == MAP_FAILED) return 0;
+	if (validJournalHeader((const unsigned char*)data, size))
+		result = replayJournal(vs, (const unsigned char*)data, size, 
+			&end);
+	munmap(data, (size_t)size);
+	if (result != 1) return result;
+	if (end == 0) return checkpointJournal(journal);
+	return ftruncate(journal->fd, (off_t)end) == 0 && 
+		lseek(journal->fd, (off_t)end, SEEK_SET) == (off_t)end;
+}
+
+/**
+ * @brief Abre o diário das mutações, criando-o se não existir. As entradas 
+ * de um diário existente posteriores ao estado atual (vazio ou carregado de 
+ * um snapshot) são reaplicadas antes de o diário receber novas entradas.
+ * 
+ * @param vs O sistema de vacinação.
+ * @param path O caminho do diário.
+ * @param group_size O número de mutações por sincronização com o disco, ou 
+ * 0 para só sincronizar nos checkpoints e no fim.
+ * 
+ * @return 1 em caso de sucesso, 0 se o diário não puder ser aberto, for 
+ * inválido ou não corresponder ao estado e -1 se faltar memória.
+ */
+int openJournal(VaccinationSystem *vs, const char *path, int group_size) {
+	Journal *journal = &vs->journal;
+	struct stat info;
+	int result = 0;
+	journal->fd = open(path, O_RDWR | O_CREAT, 0644);
+	if (journal->fd < 0) return 0;
+	journal->group_size = group_size;
+	if (fstat(journal->fd, &info) == 0 && S_ISREG(info.st_mode))
+		result = info.st_size == 0 ? checkpointJournal(journal) : 
+			recoverJournal(vs, (uint64_t)info.st_size);
+	if (result != 1) {
+		close(journal->fd);
+		journal->fd = -1;
+	}
+	return result;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file journal.h
+ * @author Diogo Lobo (ist1109293)
+ * @brief Cabeçalho do diário (write-ahead log) das mutações do sistema de 
+ * vacinação, guardadas numa codificação binária compacta e sincronizadas 
+ * com o disco em grupo.
+ * @date 2026-10-16
+ */
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "date.h"
+
+struct VaccinationSystem;
+
+/** Identificação dos arquivos de diário. */
+#define JOURNAL_MAGIC "IAEDJRNL"
+
+/** Versão do formato do diário. */
+#define JOURNAL_VERSION 1
+
+/** Marcador da ordem dos bytes de quem escreveu o diário. */
+#define JOURNAL_BYTE_ORDER 0x01020304u
+
+/** Número máximo de mutações sincronizadas de cada vez com o disco, por 
+ * padrão. O grupo é sincronizado mais cedo se houver saída a escrever. */
+#define JOURNAL_GROUP_SIZE 64
+
+/** Capacidade inicial do buffer de escrita do diário. */
+#define JOURNAL_BUFFER_SIZE (1 << 16)
+
+/** Semente do código de verificação de cada entrada do diário. */
+#define JOURNAL_CHECKSUM_SEED 0x9e3779b97f4a7c15ull
+
+/** Entrada que cria um lote: ID, data, doses e nome da vacina. */
+#define JOURNAL_CREATE 'c'
+/** Entrada que aplica uma dose: usuário e ID do lote. */
+#define JOURNAL_APPLY 'a'
+/** Entrada que retira um lote: ID do lote. */
+#define JOURNAL_REMOVE 'r'
+/** Entrada que apaga registros: usuário e, opcionalmente, data e lote. */
+#define JOURNAL_DELETE 'd'
+/** Entrada que avança a data atual: a nova data. */
+#define JOURNAL_TIME 't'
+
+/** Indica que uma entrada JOURNAL_DELETE tem a data da vacinação. */
+#define JOURNAL_DELETE_DATE 1
+/** Indica que uma entrada JOURNAL_DELETE tem o ID do lote. */
+#define JOURNAL_DELETE_BATCH 2
+
+/** Cabeçalho do diário. Seguem-se as entradas, cada uma com o tamanho e o 
+ * código de verificação (32 bits cada) antes do conteúdo. */
+typedef struct JournalHeader {
+    char magic[8]; /** Sempre JOURNAL_MAGIC, sem '\0'. */
+    uint32_t version; /** Versão do formato, JOURNAL_VERSION. */
+    uint32_t byte_order; /** JOURNAL_BYTE_ORDER na ordem de quem o 
+    escreveu. */
+    uint64_t base_lsn; /** Número da mutação da primeira entrada. */
+} JournalHeader;
+
+/** Estrutura que representa o diário das mutações. Mesmo sem arquivo, as 
+ * mutações são contadas, para que um snapshot saiba a partir de que 
+ * entrada o diário ainda tem de ser reaplicado. */
+typedef struct Journal {
+    int fd; /** Descritor do arquivo do diário, ou -1 se desativado. */
+    unsigned char *buffer; /** Entradas ainda não escritas no arquivo. */
+    size_t used; /** Número de bytes no buffer. */
+    size_t capacity; /** Capacidade do buffer. */
+    size_t start; /** Início da entrada em construção no buffer. */
+    int pending; /** Número de entradas ainda não sincronizadas. */
+    int group_size; /** Número máximo de entradas por sincronização, ou 0 
+    para só sincronizar nos checkpoints e no fim, sem garantir que as 
+    mutações já confirmadas ao cliente estão no disco. */
+    int failed; /** 1 se faltou memória para uma entrada. */
+    uint64_t next_lsn; /** Número da próxima mutação. */
+} Journal;
+
+void initJournal(Journal *journal);
+
+int openJournal(struct VaccinationSystem *vs, const char *path, 
+int group_size);
+
+int journalCreateBatch(Journal *journal, const char *batch_id, Date date, 
+int doses, const char *vaccine_name);
+
+int journalApplyDose(Journal *journal, const char *user_name, 
+const char *batch_id);
+
+int journalRemoveBatch(Journal *journal, const char *batch_id);
+
+int journalDeleteRecords(Journal *journal, const char *user_name, 
+int flags, Date date, const char *batch_id);
+
+int journalPassTime(Journal *journal, Date date);
+
+int syncJournal(Journal *journal);
+
+int checkpointJournal(Journal *journal);
+
+int closeJournal(Journal *journal);
+
+#endif
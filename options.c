@@ -0,0 +1,97 @@
+/**
+ * @file options.c
+ * @author Diogo Lobo (ist1109293)
+ * @brief Implementação da leitura dos argumentos da linha de comando.
+ * @date 2026-10-16
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include "constants.h"
+#include "journal.h"
+#include "options.h"
+
+/**
+ * @brief Lê o valor inteiro não negativo de uma opção.
+ * 
+ * @param text O texto do valor.
+ * @param value O valor lido.
+ * 
+ * @return 1 se o texto for um inteiro não negativo, 0 caso contrário.
+ */
+int parseOptionCount(const char* text, int* value) {
+	char *end;
+	long number = strtol(text, &end, 10);
+	if (*text == '\0' || *end != '\0' || number < 0 || number > INT_MAX) 
+		return 0;
+	*value = (int)number;
+	return 1;
+}
+
+/**
+ * @brief Lê uma opção com valor.
+ * 
+ * @param name O nome da opção.
+ * @param value O argumento seguinte, ou NULL se não existir.
+ * @param options As opções a preencher.
+ * 
+ * @return 1 se a opção foi lida, 0 se o valor faltar ou não for válido e -1
+ * se o argumento não for uma opção com valor.
+ */
+int parseOptionValue(const char* name, const char* value, Options* options) {
+	const char **path = NULL;
+	int *count = NULL;
+	if (strcmp(name, IMPORT_OPTION) == 0) path = &options->import_path;
+	else if (strcmp(name, RESTORE_OPTION) == 0) 
+		path = &options->restore_path;
+	else if (strcmp(name, JOURNAL_OPTION) == 0) 
+		path = &options->journal_path;
+	else if (strcmp(name, JOURNAL_SYNC_OPTION) == 0) 
+		count = &options->journal_sync;
+	else if (strcmp(name, SHARDS_OPTION) == 0) count = &options->shards;
+	else if (strcmp(name, MAX_BATCHES_OPTION) == 0) 
+		count = &options->max_batches;
+	else return -1;
+	if (value == NULL) return 0;
+	if (count != NULL) return parseOptionCount(value, count);
+	*path = value;
+	return 1;
+}
+
+/**
+ * @brief Lê os argumentos da linha de comando. O argumento "pt" escolhe o 
+ * idioma das mensagens de erro, `--import arquivo` ativa a importação em 
+ * massa, `--restore arquivo` carrega um snapshot, `--journal arquivo` ativa
+ * o diário das mutações, `--journal-sync n` muda o número máximo de 
+ * mutações por sincronização do diário, `--shards n` divide os registros em 
+ * n partições e `--max-batches n` muda o número máximo de lotes; os 
+ * restantes argumentos são ignorados.
+ * 
+ * @param argc O número de argumentos.
+ * @param argv Os argumentos, começando pelo nome do programa.
+ * @param options As opções a preencher.
+ * 
+ * @return 1 em caso de sucesso, 0 se uma opção não tiver um valor válido 
+ * ou o número de partições não estiver entre 1 e MAX_SHARDS.
+ */
+int parseOptions(int argc, char* argv[], Options* options) {
+	int i, result;
+	options->pt = 0;
+	options->import_path = NULL;
+	options->restore_path = NULL;
+	options->journal_path = NULL;
+	options->journal_sync = JOURNAL_GROUP_SIZE;
+	options->shards = 1;
+	options->max_batches = MAX_BATCHES_NUMBER;
+	for (i = 1; i < argc; i++) {
+		if (strcmp(argv[i], PT_LANG_ARGUMENT) == 0) options->pt = 1;
+		else {
+			result = parseOptionValue(argv[i], 
+				i + 1 < argc ? argv[i + 1] : NULL, options);
+			if (result == 0) return 0;
+			if (result == 1) i++;
+		}
+	}
+	return options->shards >= 1 && options->shards <= MAX_SHARDS;
+}
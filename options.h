@@ -0,0 +1,50 @@
+/**
+ * @file options.h
+ * @author Diogo Lobo (ist1109293)
+ * @brief Cabeçalho da leitura dos argumentos da linha de comando.
+ * @date 2026-10-16
+ */
+
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+/** Opção que ativa o modo de importação em massa de um arquivo. */
+#define IMPORT_OPTION "--import"
+
+/** Opção que define o número máximo de lotes, 0 para não haver limite. */
+#define MAX_BATCHES_OPTION "--max-batches"
+
+/** Opção que carrega o estado inicial do sistema de um snapshot. */
+#define RESTORE_OPTION "--restore"
+
+/** Opção que ativa o diário das mutações no arquivo dado. */
+#define JOURNAL_OPTION "--journal"
+
+/** Opção que define o número de mutações por sincronização do diário. */
+#define JOURNAL_SYNC_OPTION "--journal-sync"
+
+/** Opção que divide os registros em partições, cada uma com a sua thread. */
+#define SHARDS_OPTION "--shards"
+
+/** Estrutura que guarda as opções do programa. */
+typedef struct Options {
+    int pt; /** 1 para mensagens de erro em português. */
+    const char *import_path; /** Arquivo a importar, ou NULL para ler os 
+    comandos da entrada padrão. */
+    const char *restore_path; /** Snapshot a carregar antes do primeiro 
+    comando, ou NULL para começar com o sistema vazio. */
+    const char *journal_path; /** Diário das mutações, ou NULL para não 
+    guardar as mutações. */
+    int journal_sync; /** Número máximo de mutações por sincronização do 
+    diário, que é também sincronizado antes de cada escrita da saída; 0 
+    para só sincronizar nos checkpoints e no fim, o que não é seguro: as 
+    mutações já confirmadas podem perder-se numa falha. */
+    int shards; /** Número de partições dos registros, 1 para correr todos 
+    os comandos na thread principal. */
+    int max_batches; /** Número máximo de lotes, ou 0 para não haver 
+    limite. */
+} Options;
+
+int parseOptions(int argc, char* argv[], Options* options);
+
+#endif
@@ -0,0 +1,222 @@
+/**
+ * @file output.c
+ * @author Diogo Lobo (ist1109293)
+ * @brief Implementação do escritor de saída com buffer e formatação manual
+ * de inteiros e datas.
+ * @date 2026-10-16
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "output.h"
+
+/** Número máximo de algarismos de um inteiro, incluindo o sinal. */
+#define INT_DIGITS_SIZE 12
+
+/**
+ * @brief Inicializa um escritor de saída associado a um fluxo.
+ * 
+ * @param out O escritor a inicializar.
+ * @param stream O fluxo onde a saída é escrita.
+ * 
+ * @return 1 em caso de sucesso, 0 se a alocação do buffer falhar.
+ */
+int initOutput(Output *out, FILE *stream) {
+	out->buffer = (char*)malloc(OUTPUT_BUFFER_SIZE);
+	if (out->buffer == NULL) return 0;
+	out->used = 0;
+	out->capacity = OUTPUT_BUFFER_SIZE;
+	out->stream = stream;
+	out->failed = 0;
+	out->before_flush = NULL;
+	out->context = NULL;
+	return 1;
+}
+
+/**
+ * @brief Inicializa um escritor de saída que guarda a saída em memória, 
+ * sem a escrever em nenhum fluxo.
+ * 
+ * @param out O escritor a inicializar.
+ * @param capacity A capacidade inicial do buffer, maior do que 0.
+ * 
+ * @return 1 em caso de sucesso, 0 se a alocação do buffer falhar.
+ */
+int initMemoryOutput(Output *out, size_t capacity) {
+	out->buffer = (char*)malloc(capacity);
+	if (out->buffer == NULL) return 0;
+	out->used = 0;
+	out->capacity = capacity;
+	out->stream = NULL;
+	out->failed = 0;
+	out->before_flush = NULL;
+	out->context = NULL;
+	return 1;
+}
+
+/**
+ * @brief Aumenta o buffer de uma saída em memória até caberem mais bytes.
+ * 
+ * @param out O escritor de saída, sem fluxo.
+ * @param length O número de bytes que têm de caber no buffer.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+int growOutput(Output *out, size_t length) {
+	size_t capacity = out->capacity;
+	char *buffer;
+	while (capacity - out->used < length) capacity *= 2;
+	buffer = (char*)realloc(out->buffer, capacity);
+	if (buffer == NULL) {
+		out->failed = 1;
+		return 0;
+	}
+	out->buffer = buffer;
+	out->capacity = capacity;
+	return 1;
+}
+
+/**
+ * @brief Entrega a quem chama o buffer com a saída acumulada, sem a 
+ * escrever, e continua com um buffer novo e vazio.
+ * 
+ * @param out O escritor de saída.
+ * @param buffer O buffer com a saída acumulada, a liberar por quem chama.
+ * @param length O número de bytes no buffer.
+ * 
+ * @return 1 em caso de sucesso, 0 se a alocação do buffer novo falhar.
+ */
+int detachOutput(Output *out, char **buffer, size_t *length) {
+	char *fresh = (char*)malloc(out->capacity);
+	if (fresh == NULL) return 0;
+	*buffer = out->buffer;
+	*length = out->used;
+	out->buffer = fresh;
+	out->used = 0;
+	return 1;
+}
+
+/**
+ * @brief Escreve no fluxo de destino toda a saída acumulada no buffer, 
+ * depois da saída que a antecede, se houver. Numa saída em memória não faz 
+ * nada.
+ * 
+ * @param out O escritor de saída.
+ */
+void flushOutput(Output *out) {
+	if (out->stream == NULL) return;
+	if (out->before_flush != NULL) out->before_flush(out->context);
+	if (out->used > 0) fwrite(out->buffer, 1, out->used, out->stream);
+	out->used = 0;
+	fflush(out->stream);
+}
+
+/**
+ * @brief Acrescenta uma sequência de bytes à saída. Sequências maiores do
+ * que o buffer são escritas diretamente no fluxo, ou fazem crescer o buffer
+ * de uma saída em memória.
+ * 
+ * @param out O escritor de saída.
+ * @param bytes Os bytes a escrever.
+ * @param length O número de bytes.
+ */
+void outputBytes(Output *out, const char *bytes, size_t length) {
+	if (out->capacity - out->used < length) {
+		if (out->stream == NULL) {
+			if (!growOutput(out, length)) return;
+		} else {
+			flushOutput(out);
+			if (length > out->capacity) {
+				fwrite(bytes, 1, length, out->stream);
+				return;
+			}
+		}
+	}
+	memcpy(out->buffer + out->used, bytes, length);
+	out->used += length;
+}
+
+/**
+ * @brief Acrescenta um caractere à saída.
+ * 
+ * @param out O escritor de saída.
+ * @param c O caractere a escrever.
+ */
+void outputChar(Output *out, char c) {
+	if (out->used == out->capacity) {
+		if (out->stream != NULL) flushOutput(out);
+		else if (!growOutput(out, 1)) return;
+	}
+	out->buffer[out->used++] = c;
+}
+
+/**
+ * @brief Acrescenta uma string terminada em '\0' à saída.
+ * 
+ * @param out O escritor de saída.
+ * @param string A string a escrever.
+ */
+void outputString(Output *out, const char *string) {
+	outputBytes(out, string, strlen(string));
+}
+
+/**
+ * @brief Escreve os algarismos de um inteiro sem sinal, preenchendo à
+ * esquerda com zeros até o número mínimo de algarismos indicado.
+ * 
+ * @param out O escritor de saída.
+ * @param value O valor a escrever.
+ * @param min_digits O número mínimo de algarismos.
+ */
+void outputPaddedUnsigned(Output *out, unsigned int value, int min_digits) {
+	char digits[INT_DIGITS_SIZE];
+	int i = INT_DIGITS_SIZE;
+	do {
+		digits[--i] = (char)('0' + value % 10);
+		value /= 10;
+	} while (value > 0);
+	while (INT_DIGITS_SIZE - i < min_digits) digits[--i] = '0';
+	outputBytes(out, digits + i, INT_DIGITS_SIZE - i);
+}
+
+/**
+ * @brief Acrescenta um inteiro em base decimal à saída, como "%d".
+ * 
+ * @param out O escritor de saída.
+ * @param value O valor a escrever.
+ */
+void outputInt(Output *out, int value) {
+	unsigned int magnitude = (unsigned int)value;
+	if (value < 0) {
+		outputChar(out, '-');
+		magnitude = 0u - magnitude;
+	}
+	outputPaddedUnsigned(out, magnitude, 1);
+}
+
+/**
+ * @brief Acrescenta uma data à saída no formato dd-mm-aaaa, como 
+ * "%02d-%02d-%04d".
+ * 
+ * @param out O escritor de saída.
+ * @param date A data a escrever.
+ */
+void outputDate(Output *out, Date date) {
+	outputPaddedUnsigned(out, dateDay(date), 2);
+	outputChar(out, '-');
+	outputPaddedUnsigned(out, dateMonth(date), 2);
+	outputChar(out, '-');
+	outputPaddedUnsigned(out, dateYear(date), 4);
+}
+
+/**
+ * @brief Escreve a saída pendente e libera o buffer do escritor.
+ * 
+ * @param out O escritor de saída.
+ */
+void destroyOutput(Output *out) {
+	if (out->buffer == NULL) return;
+	flushOutput(out);
+	free(out->buffer);
+	out->buffer = NULL;
+}
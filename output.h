@@ -0,0 +1,57 @@
+/**
+ * @file output.h
+ * @author Diogo Lobo (ist1109293)
+ * @brief Cabeçalho do escritor de saída. Toda a saída do programa é
+ * acumulada num buffer grande e reutilizado, com formatação manual de
+ * inteiros e datas, e só é escrita no fluxo de destino quando o buffer
+ * enche ou antes de o programa ficar à espera de mais entrada. Um escritor
+ * sem fluxo guarda a saída em memória, aumentando o buffer quando enche.
+ * @date 2026-10-16
+ */
+
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include "date.h"
+
+/** Capacidade, em bytes, do buffer de saída. */
+#define OUTPUT_BUFFER_SIZE 65536
+
+/** Estrutura que representa um escritor de saída com buffer. */
+typedef struct Output {
+    char *buffer; /** Buffer com a saída ainda não escrita. */
+    size_t used; /** Número de bytes ocupados no buffer. */
+    size_t capacity; /** Capacidade do buffer em bytes. */
+    FILE *stream; /** Fluxo onde a saída é escrita, ou NULL se a saída 
+    fica só em memória. */
+    int failed; /** 1 se faltou memória para aumentar o buffer de uma saída 
+    em memória. */
+    void (*before_flush)(void *context); /** Função chamada antes de cada 
+    escrita no fluxo, para escrever primeiro a saída que a antecede, ou 
+    NULL. */
+    void *context; /** Argumento de `before_flush`. */
+} Output;
+
+int initOutput(Output *out, FILE *stream);
+
+int initMemoryOutput(Output *out, size_t capacity);
+
+void outputBytes(Output *out, const char *bytes, size_t length);
+
+void outputChar(Output *out, char c);
+
+void outputString(Output *out, const char *string);
+
+void outputInt(Output *out, int value);
+
+void outputDate(Output *out, Date date);
+
+int detachOutput(Output *out, char **buffer, size_t *length);
+
+void flushOutput(Output *out);
+
+void destroyOutput(Output *out);
+
+#endif
@@ -0,0 +1,171 @@
+/**
+ * @file radix.c
+ * @author Diogo Lobo (ist1109293)
+ * @brief Implementação da ordenação radix.
+ * @date 2026-10-16
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "radix.h"
+
+/**
+ * @brief Escolhe o número de threads de uma ordenação: uma por processador 
+ * disponível, até RADIX_MAX_THREADS, e só se houver muitos elementos.
+ * 
+ * @param count O número de elementos.
+ * 
+ * @return O número de threads.
+ */
+int radixThreadCount(size_t count) {
+	long threads = sysconf(_SC_NPROCESSORS_ONLN);
+	if (count < RADIX_PARALLEL_MIN || threads < 1) return 1;
+	if ((size_t)threads > count / (RADIX_PARALLEL_MIN / 4))
+		threads = (long)(count / (RADIX_PARALLEL_MIN / 4));
+	return threads > RADIX_MAX_THREADS ? RADIX_MAX_THREADS : (int)threads;
+}
+
+/**
+ * @brief Conta os elementos de uma parte em cada balde do dígito da 
+ * passagem.
+ * 
+ * @param arg A parte (RadixTask).
+ * 
+ * @return NULL.
+ */
+void* radixCount(void *arg) {
+	RadixTask *task = (RadixTask*)arg;
+	size_t i;
+	memset(task->counts, 0, sizeof(task->counts));
+	for (i = task->begin; i < task->end; i++)
+		task->counts[(task->from[i].key >> task->shift) & 
+			(RADIX_BUCKETS - 1)]++;
+	return NULL;
+}
+
+/**
+ * @brief Copia os elementos de uma parte para as posições dos seus baldes, 
+ * mantendo a ordem relativa dos elementos do mesmo balde.
+ * 
+ * @param arg A parte (RadixTask), com as posições de escrita de cada balde.
+ * 
+ * @return NULL.
+ */
+void* radixScatter(void *arg) {
+	RadixTask *task = (RadixTask*)arg;
+	size_t i;
+	for (i = task->begin; i < task->end; i++)
+		task->to[task->counts[(task->from[i].key >> task->shift) & 
+			(RADIX_BUCKETS - 1)]++] = task->from[i];
+	return NULL;
+}
+
+/**
+ * @brief Corre uma fase de uma passagem em todas as partes, cada uma na 
+ * sua thread; a primeira parte e as que não conseguem thread correm na 
+ * thread atual.
+ * 
+ * @param tasks As partes.
+ * @param threads O número de partes.
+ * @param phase A fase (radixCount ou radixScatter).
+ */
+void radixRunPhase(RadixTask *tasks, int threads, void *(*phase)(void*)) {
+	int i, started[RADIX_MAX_THREADS];
+	for (i = 1; i < threads; i++) {
+		started[i] = pthread_create(&tasks[i].thread, NULL, phase, 
+			&tasks[i]) == 0;
+		if (!started[i]) phase(&tasks[i]);
+	}
+	phase(&tasks[0]);
+	for (i = 1; i < threads; i++)
+		if (started[i]) pthread_join(tasks[i].thread, NULL);
+}
+
+/**
+ * @brief Transforma as contagens de cada parte nas suas posições de 
+ * escrita: os baldes seguem-se por ordem e, dentro de cada balde, as 
+ * partes também, o que mantém a ordenação estável.
+ * 
+ * @param tasks As partes.
+ * @param threads O número de partes.
+ * @param count O número total de elementos.
+ * 
+ * @return 1 se a passagem muda a ordem, 0 se todos os elementos estão no 
+ * mesmo balde e a passagem pode ser saltada.
+ */
+int radixOffsets(RadixTask *tasks, int threads, size_t count) {
+	size_t position = 0, bucket_count, value;
+	int bucket, i;
+	for (bucket = 0; bucket < RADIX_BUCKETS; bucket++) {
+		bucket_count = 0;
+		for (i = 0; i < threads; i++) {
+			value = tasks[i].counts[bucket];
+			tasks[i].counts[bucket] = position + bucket_count;
+			bucket_count += value;
+		}
+		if (bucket_count == count) return 0;
+		position += bucket_count;
+	}
+	return 1;
+}
+
+/**
+ * @brief Divide os elementos em partes iguais, uma por thread.
+ * 
+ * @param tasks As partes.
+ * @param threads O número de partes.
+ * @param count O número total de elementos.
+ */
+void radixSplit(RadixTask *tasks, int threads, size_t count) {
+	int i;
+	for (i = 0; i < threads; i++) {
+		tasks[i].begin = count / threads * i;
+		tasks[i].end = i == threads - 1 ? count : 
+			count / threads * (i + 1);
+	}
+}
+
+/**
+ * @brief Ordena elementos pela chave, por ordem crescente, de forma 
+ * estável. Cada passagem ordena RADIX_BITS bits da chave, do menos para o 
+ * mais significativo, e só são feitas as passagens até ao bit mais alto 
+ * da maior chave; as passagens em que todas as chaves têm o mesmo dígito 
+ * são saltadas, pelo que uma entrada já quase ordenada custa pouco.
+ * 
+ * @param items Os elementos.
+ * @param count O número de elementos.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória, caso em que os 
+ * elementos ficam como estavam.
+ */
+int radixSort(RadixItem *items, size_t count) {
+	RadixTask tasks[RADIX_MAX_THREADS];
+	RadixItem *buffer, *from = items, *to, *swap;
+	unsigned long long max_key = 0;
+	int threads = radixThreadCount(count), shift, i;
+	size_t j;
+	if (count < 2) return 1;
+	if ((buffer = malloc(sizeof(RadixItem) * count)) == NULL) return 0;
+	to = buffer;
+	for (j = 0; j < count; j++)
+		if (items[j].key > max_key) max_key = items[j].key;
+	radixSplit(tasks, threads, count);
+	for (shift = 0; shift < 64 && (max_key >> shift) != 0; 
+		shift += RADIX_BITS) {
+		for (i = 0; i < threads; i++) {
+			tasks[i].from = from;
+			tasks[i].to = to;
+			tasks[i].shift = shift;
+		}
+		radixRunPhase(tasks, threads, radixCount);
+		if (!radixOffsets(tasks, threads, count)) continue;
+		radixRunPhase(tasks, threads, radixScatter);
+		swap = from;
+		from = to;
+		to = swap;
+	}
+	if (from != items) memcpy(items, from, sizeof(RadixItem) * count);
+	free(buffer);
+	return 1;
+}
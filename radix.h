@@ -0,0 +1,48 @@
+/**
+ * @file radix.h
+ * @author Diogo Lobo (ist1109293)
+ * @brief Cabeçalho da ordenação radix (LSD) de pares chave-valor com 
+ * chaves inteiras de 64 bits, feita em várias threads quando há muitos 
+ * elementos.
+ * @date 2026-10-16
+ */
+
+#ifndef RADIX_H
+#define RADIX_H
+
+#include <pthread.h>
+#include <stddef.h>
+
+/** Número de bits da chave ordenados em cada passagem. */
+#define RADIX_BITS 8
+
+/** Número de baldes de cada passagem. */
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+
+/** Número mínimo de elementos para ordenar em várias threads. */
+#define RADIX_PARALLEL_MIN 65536
+
+/** Número máximo de threads de uma ordenação. */
+#define RADIX_MAX_THREADS 16
+
+/** Elemento a ordenar: a chave e o valor que a acompanha. */
+typedef struct RadixItem {
+    unsigned long long key; /** Chave de ordenação. */
+    void *value; /** Valor associado à chave. */
+} RadixItem;
+
+/** Parte dos elementos de uma passagem tratada por uma thread. */
+typedef struct RadixTask {
+    pthread_t thread; /** Thread do sistema. */
+    const RadixItem *from; /** Elementos antes da passagem. */
+    RadixItem *to; /** Elementos depois da passagem. */
+    size_t begin; /** Primeiro elemento da parte. */
+    size_t end; /** Fim da parte, exclusivo. */
+    int shift; /** Posição do dígito da passagem na chave. */
+    size_t counts[RADIX_BUCKETS]; /** Elementos da parte em cada balde; 
+    depois, a posição de escrita de cada balde. */
+} RadixTask;
+
+int radixSort(RadixItem *items, size_t count);
+
+#endif
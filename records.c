@@ -6,51 +6,46 @@
  * @date 2025-04-07
  */
 
+/** Expõe strdup, que é POSIX, mesmo quando se compila em C99 estrito. */
+#define _POSIX_C_SOURCE 200809L
 #include <stdlib.h>
-#include <stdio.h>
 #include "records.h"
 #include "constants.h"
-#include "utils.h"
 #include "date.h"
+#include "radix.h"
+#include "batch.h"
 
 /**
- * @brief Função hash para mapear o nome do usuário para um índice na tabela 
- * de hash.
+ * @brief Devolve a chave de um usuário na tabela de hash, o seu nome.
  * 
- * @param v Nome do usuário.
- * @param table_size Tamanho da tabela de hash.
+ * @param entry O usuário (VaccinationRecordsUser).
  * 
- * @return Índice gerado pela função hash.
+ * @return O nome do usuário.
  */
-int hash_user(const char *v, int table_size) {
-	int h = 0, a = 127;
-	for (; *v != '\0'; v++)
-		h = (a * h + *v) % table_size;
-	return h;
+const char* userKey(const void *entry) {
+	return ((const VaccinationRecordsUser*)entry)->user;
 }
 
 /**
  * @brief Cria um registro de vacinação.
  * 
- * @param user_name Nome do usuário.
- * @param vaccine_name Nome da vacina.
- * @param batch_id Identificação do lote.
+ * @param user Usuário dono do registro.
+ * @param batch Lote aplicado.
  * @param vaccination_date Data da vacinação.
- * @param id Identificador do registro.
+ * @param seq Número de sequência do registro.
  * 
  * @return Ponteiro para o novo registro de vacinação.
  */
-VaccinationRecord* createVaccinationRecord(const char *user_name, 
-	const char *vaccine_name, const char* batch_id, 
-	Date vaccination_date, int id) {
+VaccinationRecord* createVaccinationRecord(VaccinationRecordsUser *user, 
+	BatchInfo *batch, Date vaccination_date, unsigned long long seq) {
 	VaccinationRecord *record;
 	record = (VaccinationRecord*)malloc(sizeof(VaccinationRecord));
 	if (!record) return NULL;
-	record->user_name = strdup(user_name);
-	record->vaccine_name = strdup(vaccine_name);
-	record->batch_id = strdup(batch_id);
+	record->user = user;
+	record->batch = batch;
+	record->vaccine_id = batch->vaccine_id;
 	record->vaccination_date = vaccination_date;
-	record->record_id = id;
+	record->seq = seq;
 	return record;
 }
 
@@ -66,9 +61,11 @@ VaccinationRecordsUser* createVaccinationRecordsUser(const char *user_name) {
 		sizeof(VaccinationRecordsUser));
 	if (!user) return NULL;
 	user->user = strdup(user_name);
-	user->records = NULL;
+	user->records = user->inline_records;
+	user->dates = user->inline_dates;
 	user->record_count = 0;
-	user->next = NULL;
+	user->record_capacity = USER_INLINE_RECORDS;
+	initRecordSet(&user->vaccinations);
 	return user;
 }
 
@@ -79,61 +76,22 @@ VaccinationRecordsUser* createVaccinationRecordsUser(const char *user_name) {
  */
 VaccinationRecordsHashtable* initVaccinationRecordsHashtable() {
 	VaccinationRecordsHashtable *ht;
-	int i;
 	ht = (VaccinationRecordsHashtable*)malloc(
 		sizeof(VaccinationRecordsHashtable));
 	if (ht == NULL) return NULL;
-	ht->vaccination_records = (VaccinationRecordsUser**)malloc(
-		INITIAL_TABLE_SIZE * sizeof(VaccinationRecordsUser*));
-	if (ht->vaccination_records == NULL) {
+	if (!initHashTable(&ht->users, userKey)) {
 		free(ht);
 		return NULL;
 	}
-	for (i = 0; i < INITIAL_TABLE_SIZE; i++)
-		ht->vaccination_records[i] = NULL;
-	ht->users_count = 0;
-	ht->size = INITIAL_TABLE_SIZE;
 	ht->all_records_count = 0;
+	ht->log.seqs = NULL;
+	ht->log.records = NULL;
+	ht->log.count = ht->log.capacity = 0;
+	ht->next_seq = 0;
+	initRetireList(&ht->retired, NULL);
 	return ht;
 }
 
-/**
- * @brief Redimensiona a tabela de hash para um novo tamanho.
- * 
- * @param ht Tabela de hash de registros de vacinação.
- * @param new_size Novo tamanho da tabela.
- * 
- * @return 1 se o redimensionamento foi bem-sucedido, 0 caso contrário.
- */
-int resizeVaccinationRecordsHashtable(VaccinationRecordsHashtable *ht, 
-	int new_size) {
-	int i;
-	unsigned int index;
-	VaccinationRecordsUser *user, *temp;
-	VaccinationRecordsUser **new_vaccination_records;
-	if (new_size < INITIAL_TABLE_SIZE) return 1;
-	if (new_size == ht->size) return 1;
-	new_vaccination_records = (VaccinationRecordsUser**)malloc(
-		new_size * sizeof(VaccinationRecordsUser*));
-	if (!new_vaccination_records) return 0;
-	for (i = 0; i < new_size; i++)
-		new_vaccination_records[i] = NULL;
-	for (i = 0; i < ht->size; i++) {
-		user = ht->vaccination_records[i];
-		while (user) {
-			index = hash_user(user->user, new_size);
-			temp = user->next;
-			user->next = new_vaccination_records[index];
-			new_vaccination_records[index] = user;
-			user = temp;
-		}
-	}
-	free(ht->vaccination_records);
-	ht->vaccination_records = new_vaccination_records;
-	ht->size = new_size;
-	return 1;
-}
-
 /**
  * @brief Encontra um usuário na tabela de hash.
  * 
@@ -144,14 +102,7 @@ int resizeVaccinationRecordsHashtable(VaccinationRecordsHashtable *ht,
  */
 VaccinationRecordsUser *findUser(VaccinationRecordsHashtable *ht, 
 	const char *user_name) {
-	unsigned int hash_index;
-	hash_index = hash_user(user_name, ht->size);
-	VaccinationRecordsUser *user = ht->vaccination_records[hash_index];
-	while (user) {
-		if (strcmp(user->user, user_name) == 0) return user;
-		user = user->next;
-	}
-	return NULL;
+	return hashTableFind(&ht->users, user_name);
 }
 
 /**
@@ -162,27 +113,31 @@ VaccinationRecordsUser *findUser(VaccinationRecordsHashtable *ht,
  * 
  * @return 1 se o usuário existe, 0 caso contrário.
  */
-int userExistInSystem(VaccinationRecordsHashtable *ht, char* user) {
+int userExistInSystem(VaccinationRecordsHashtable *ht, const char* user) {
 	return findUser(ht, user) != NULL;
 }
 
 /**
  * @brief Verifica se o usuário já foi vacinado com a vacina na data informada.
+ * Com poucos registros é percorrida a coluna das datas, e só os registros 
+ * dessa data são lidos; a partir de RECORD_SET_MIN_RECORDS é consultado o 
+ * conjunto de pares (vacina, data) do usuário, em tempo constante.
  * 
  * @param user Usuário cujos registros serão verificados.
- * @param vaccine_name Nome da vacina.
+ * @param vaccine_id ID da vacina no catálogo de vacinas.
  * @param date Data da vacinação.
  * 
  * @return 1 se o usuário já foi vacinado, 0 caso contrário.
  */
-int isAlreadyVaccinated(VaccinationRecordsUser *user, const char *vaccine_name, 
+int isAlreadyVaccinated(VaccinationRecordsUser *user, int vaccine_id, 
 	Date date) {
 	int i;
 	if (!user) return 0;
+	if (user->vaccinations.capacity > 0)
+		return recordSetContains(&user->vaccinations, vaccine_id, date);
 	for (i = 0; i < user->record_count; i++) {
-		if (strcmp(user->records[i]->vaccine_name, vaccine_name) == 0 &&
-			compareDate1Date2(user->records[i]->vaccination_date, 
-				date) == 0) {
+		if (compareDate1Date2(user->dates[i], date) == 0 && 
+			user->records[i]->vaccine_id == vaccine_id) {
 			return 1;
 		}
 	}
@@ -190,40 +145,180 @@ int isAlreadyVaccinated(VaccinationRecordsUser *user, const char *vaccine_name,
 }
 
 /**
- * @brief Insere um registro de vacinação para um usuário existente.
+ * @brief Acrescenta o par (vacina, data) de um novo registro ao conjunto do
+ * usuário, criando o conjunto com todos os registros quando o usuário 
+ * atinge RECORD_SET_MIN_RECORDS registros.
+ * 
+ * @param user Usuário a quem o registro já foi acrescentado.
+ * @param record O novo registro.
+ * 
+ * @return 1 se a operação foi bem-sucedida, 0 em caso de erro de memória.
+ */
+int indexUserRecord(VaccinationRecordsUser *user, VaccinationRecord *record) {
+	int i;
+	if (user->vaccinations.capacity > 0)
+		return recordSetAdd(&user->vaccinations, record->vaccine_id, 
+			record->vaccination_date);
+	if (user->record_count < RECORD_SET_MIN_RECORDS) return 1;
+	for (i = 0; i < user->record_count; i++)
+		if (!recordSetAdd(&user->vaccinations, 
+			user->records[i]->vaccine_id, user->dates[i])) 
+			return 0;
+	return 1;
+}
+
+/**
+ * @brief Garante espaço para mais uma posição no registro cronológico, 
+ * duplicando a capacidade de todas as colunas quando está cheio. A 
+ * capacidade só muda quando todas as colunas cresceram.
+ * 
+ * @param log O registro cronológico.
+ * 
+ * @return 1 se existe espaço, 0 em caso de erro de memória.
+ */
+int growRecordLog(RecordLog *log) {
+	unsigned long long *seqs;
+	VaccinationRecord **records;
+	int capacity = log->capacity ? log->capacity * 2 : INITIAL_TABLE_SIZE;
+	if (log->count < log->capacity) return 1;
+	seqs = (unsigned long long*)realloc(log->seqs, 
+		sizeof(unsigned long long) * capacity);
+	if (!seqs) return 0;
+	log->seqs = seqs;
+	records = (VaccinationRecord**)realloc(log->records, 
+		sizeof(VaccinationRecord*) * capacity);
+	if (!records) return 0;
+	log->records = records;
+	log->capacity = capacity;
+	return 1;
+}
+
+/**
+ * @brief Acrescenta um registro ao fim do registro cronológico.
+ * 
+ * @param ht Tabela de hash de registros de vacinação.
+ * @param record O registro de vacinação a acrescentar.
+ * 
+ * @return 1 se a operação foi bem-sucedida, 0 caso contrário.
+ */
+int appendToRecordLog(VaccinationRecordsHashtable *ht, 
+	VaccinationRecord *record) {
+	RecordLog *log = &ht->log;
+	if (!growRecordLog(log)) return 0;
+	record->log_index = log->count;
+	log->seqs[log->count] = record->seq;
+	log->records[log->count++] = record;
+	ht->all_records_count++;
+	return 1;
+}
+
+/**
+ * @brief Cria um registro de vacinação com o próximo número de sequência e 
+ * acrescenta-o ao registro cronológico.
+ * 
+ * @param ht Tabela de hash de registros de vacinação.
+ * @param user Usuário dono do registro.
+ * @param batch Lote aplicado.
+ * @param vaccination_date Data da vacinação.
+ * 
+ * @return Ponteiro para o novo registro de vacinação, ou NULL em caso de 
+ * erro de memória.
+ */
+VaccinationRecord* newLoggedRecord(VaccinationRecordsHashtable *ht, 
+	VaccinationRecordsUser *user, BatchInfo *batch, Date vaccination_date) {
+	VaccinationRecord *record;
+	record = createVaccinationRecord(user, batch, vaccination_date, 
+		ht->next_seq);
+	if (!record) return NULL;
+	if (!appendToRecordLog(ht, record)) {
+		free(record);
+		return NULL;
+	}
+	ht->next_seq++;
+	return record;
+}
+
+/**
+ * @brief Procura, por pesquisa binária na coluna das datas, a posição da 
+ * lista de registros de um usuário onde começam os registros com data 
+ * posterior (ou, se `upper` for 0, igual ou posterior) à data indicada.
+ * 
+ * @param user Usuário cujos registros são pesquisados.
+ * @param date A data procurada.
+ * @param upper 1 para saltar também os registros com a data indicada.
+ * 
+ * @return A posição encontrada.
+ */
+int userRecordsBound(VaccinationRecordsUser *user, Date date, int upper) {
+	int low = 0, high = user->record_count, middle, cmp;
+	while (low < high) {
+		middle = low + (high - low) / 2;
+		cmp = compareDate1Date2(user->dates[middle], date);
+		if (cmp < 0 || (upper && cmp == 0)) low = middle + 1;
+		else high = middle;
+	}
+	return low;
+}
+
+/**
+ * @brief Garante espaço para mais um registro na lista de um usuário. Ao 
+ * esgotar o espaço embutido, os registros e as suas datas passam para uma 
+ * única alocação, com a coluna das datas depois da dos registros, que 
+ * depois cresce para o dobro de cada vez.
+ * 
+ * @param user Usuário cuja lista de registros é aumentada.
+ * 
+ * @return 1 se existe espaço, 0 em caso de erro de memória.
+ */
+int growUserRecords(VaccinationRecordsUser *user) {
+	VaccinationRecord **records;
+	int capacity = user->record_capacity * 2;
+	if (user->record_count < user->record_capacity) return 1;
+	records = (VaccinationRecord**)malloc(
+		(sizeof(VaccinationRecord*) + sizeof(Date)) * capacity);
+	if (!records) return 0;
+	memcpy(records, user->records, 
+		sizeof(VaccinationRecord*) * user->record_count);
+	memcpy(records + capacity, user->dates, 
+		sizeof(Date) * user->record_count);
+	if (user->records != user->inline_records) free(user->records);
+	user->records = records;
+	user->dates = (Date*)(records + capacity);
+	user->record_capacity = capacity;
+	return 1;
+}
+
+/**
+ * @brief Insere um registro de vacinação na lista de um usuário, depois 
+ * dos registros com a mesma data ou anteriores.
  * 
  * @param ht Tabela de hash de registros de vacinação.
  * @param user Usuário cujos registros serão atualizados.
- * @param user_name Nome do usuário.
- * @param vaccine_name Nome da vacina.
- * @param batch_id Identificação do lote.
+ * @param batch Lote aplicado.
  * @param vaccination_date Data da vacinação.
  * 
- * @return 1 se a inserção foi bem-sucedida, 0 caso contrário.
+ * @return 1 se a inserção foi bem-sucedida, 2 se o usuário já tinha sido 
+ * vacinado e 0 em caso de erro de memória.
  */
-int insertIntoExistingUserRecords(VaccinationRecordsHashtable *ht,
-	VaccinationRecordsUser *user, const char *user_name, 
-	const char *vaccine_name, const char *batch_id, Date vaccination_date) {
-	int i = 0;
-	if (isAlreadyVaccinated(user, vaccine_name, vaccination_date)) return 2;
-	VaccinationRecord *record = createVaccinationRecord(user_name, 
-		vaccine_name, batch_id, vaccination_date, 
-		ht->all_records_count);
+int insertIntoUserRecords(VaccinationRecordsHashtable *ht,
+	VaccinationRecordsUser *user, BatchInfo *batch, 
+	Date vaccination_date) {
+	VaccinationRecord *record;
+	int i;
+	if (isAlreadyVaccinated(user, batch->vaccine_id, vaccination_date)) 
+		return 2;
+	if (!growUserRecords(user)) return 0;
+	record = newLoggedRecord(ht, user, batch, vaccination_date);
 	if (!record) return 0;
-	user->records = (VaccinationRecord**)realloc(user->records, 
-		sizeof(VaccinationRecord*) * (user->record_count + 1));
-	if (!user->records) return 0;
-	while (i < user->record_count && 
-		compareDate1Date2(user->records[i]->vaccination_date, 
-			vaccination_date) <= 0) {
-		i++;
-	}
-	for (int j = user->record_count; j > i; j--)
-		user->records[j] = user->records[j - 1];
+	i = userRecordsBound(user, vaccination_date, 1);
+	memmove(&user->records[i + 1], &user->records[i], 
+		sizeof(VaccinationRecord*) * (user->record_count - i));
+	memmove(&user->dates[i + 1], &user->dates[i], 
+		sizeof(Date) * (user->record_count - i));
 	user->records[i] = record;
+	user->dates[i] = vaccination_date;
 	user->record_count++;
-	ht->all_records_count++;
-	return 1;
+	return indexUserRecord(user, record);
 }
 
 /**
@@ -231,173 +326,240 @@ int insertIntoExistingUserRecords(VaccinationRecordsHashtable *ht,
  * 
  * @param ht Tabela de hash de registros de vacinação.
  * @param user_name Nome do usuário.
- * @param vaccine_name Nome da vacina.
- * @param batch_id Identificação do lote.
+ * @param batch Lote aplicado.
  * @param vaccination_date Data da vacinação.
  * 
- * @return 1 se a inserção foi bem-sucedida, 0 caso contrário.
+ * @return 1 se a inserção foi bem-sucedida, 2 se o usuário já tinha sido 
+ * vacinado e 0 em caso de erro de memória.
  */
 int insertVaccinationRecord(VaccinationRecordsHashtable *ht, 
-	const char *user_name, const char *vaccine_name, const char* batch_id, 
-	Date vaccination_date) {
-	unsigned int index;
+	const char *user_name, BatchInfo *batch, Date vaccination_date) {
 	VaccinationRecordsUser *user;
-	if ((float)ht->users_count / ht->size >= MAX_LOAD_FACTOR) {
-		if (resizeVaccinationRecordsHashtable(ht, 
-			nextPrime(ht->size * 2)) == 0) return 0;
-	}
-	index = hash_user(user_name, ht->size);
 	user = findUser(ht, user_name);
-	if (user) { 
-		return insertIntoExistingUserRecords(ht, user, user_name, 
-			vaccine_name, batch_id, vaccination_date);
+	if (!user) {
+		user = createVaccinationRecordsUser(user_name);
+		if (!user || !hashTableInsert(&ht->users, user)) return 0;
 	}
-	user = createVaccinationRecordsUser(user_name);
-	if (!user) return 0;
-	user->records = (VaccinationRecord**)malloc(sizeof(VaccinationRecord*));
-	if (!user->records) return 0;
-	user->records[0] = createVaccinationRecord(user_name, vaccine_name,
-		batch_id, vaccination_date, ht->all_records_count);
-	if (!user->records[0]) return 0;
-	user->record_count = 1;
-	user->next = ht->vaccination_records[index];
-	ht->vaccination_records[index] = user;
-	ht->users_count++;
-	ht->all_records_count++;
-	return 1;
+	return insertIntoUserRecords(ht, user, batch, vaccination_date);
 }
 
 /**
- * @brief Troca dois registros de vacinação.
+ * @brief Repõe um registro de vacinação lido de um snapshot, com o seu 
+ * número de sequência original. Os registros têm de ser repostos por ordem 
+ * crescente de sequência, a ordem do registro cronológico.
  * 
- * @param a Ponteiro para o primeiro registro.
- * @param b Ponteiro para o segundo registro.
+ * @param ht Tabela de hash de registros de vacinação.
+ * @param user_name Nome do usuário.
+ * @param batch Lote aplicado.
+ * @param vaccination_date Data da vacinação.
+ * @param seq Número de sequência do registro.
+ * 
+ * @return 1 se a inserção foi bem-sucedida, 2 se o registro repete um par 
+ * (vacina, data) do usuário e 0 em caso de erro de memória.
  */
-void swap_records(VaccinationRecord **a, VaccinationRecord **b) {
-	VaccinationRecord *temp = *a;
-	*a = *b;
-	*b = temp;
+int restoreVaccinationRecord(VaccinationRecordsHashtable *ht, 
+	const char *user_name, BatchInfo *batch, Date vaccination_date, 
+	unsigned long long seq) {
+	ht->next_seq = seq;
+	return insertVaccinationRecord(ht, user_name, batch, vaccination_date);
 }
 
 /**
- * @brief Compara dois registros de vacinação.
- * 
- * @param record1 Primeiro registro de vacinação.
- * @param record2 Segundo registro de vacinação.
+ * @brief Imprime um registro de vacinação, com o nome do seu usuário e o ID 
+ * do seu lote.
  * 
- * @return Valor negativo se record1 for menor que record2, 
- * valor positivo se record1 for maior, 0 se forem iguais.
+ * @param out O escritor de saída onde o registro é impresso.
+ * @param record O registro de vacinação a ser impresso.
  */
-int compare_records(VaccinationRecord* record1, VaccinationRecord* record2) {
-	int date_cmp;
-	date_cmp = compareDate1Date2(record1->vaccination_date, 
-		record2->vaccination_date);
-	if (date_cmp == 0) {
-		if (record1->record_id < record2->record_id) return -1;
-		if (record1->record_id > record2->record_id) return 1;
-		return 0;
-	}
-	return date_cmp;
+void print_record(Output *out, VaccinationRecord *record) {
+	outputString(out, record->user->user);
+	outputChar(out, ' ');
+	outputString(out, record->batch->batch);
+	outputChar(out, ' ');
+	outputDate(out, record->vaccination_date);
+	outputChar(out, '\n');
 }
 
 /**
- * @brief Particiona os registros de vacinação para ordenação.
+ * @brief Inicializa um cursor no primeiro registro de um conjunto de 
+ * partições.
  * 
- * @param records Registros de vacinação.
- * @param low Índice inferior.
- * @param high Índice superior.
- * 
- * @return Índice do pivô.
+ * @param cursor O cursor a inicializar.
+ * @param shards As partições dos registros de vacinação.
+ * @param shard_count O número de partições, até MAX_SHARDS.
  */
-int partition_records(VaccinationRecord **records, int low, int high) {
-	VaccinationRecord *pivot;
-	int i, j;
-	pivot = records[high];
-	i = low - 1;
-	for (j = low; j < high; j++) {
-		if (compare_records(records[j], pivot) < 0) {
-			i++;
-			swap_records(&records[i], &records[j]);
-		}
-	}
-	swap_records(&records[i + 1], &records[high]);
-	return i + 1;
+void initRecordCursor(RecordCursor *cursor, 
+	VaccinationRecordsHashtable **shards, int shard_count) {
+	int i;
+	cursor->shards = shards;
+	cursor->shard_count = shard_count;
+	for (i = 0; i < shard_count; i++) cursor->positions[i] = 0;
 }
 
 /**
- * @brief Ordena os registros de vacinação usando o algoritmo QuickSort.
+ * @brief Devolve o registro seguinte de um cursor: o de menor número de 
+ * sequência entre os próximos registros não apagados de cada partição. Os 
+ * números de sequência são lidos da sua coluna, sem ler os registros.
+ * 
+ * @param cursor O cursor.
  * 
- * @param records Registros de vacinação.
- * @param low Índice inferior.
- * @param high Índice superior.
+ * @return O registro seguinte, ou NULL se já não houver registros.
  */
-void quicksort_records(VaccinationRecord **records, int low, int high) {
-	int pivotIndex;
-	if (low < high) {
-		pivotIndex = partition_records(records, low, high);
-		quicksort_records(records, low, pivotIndex - 1);
-		quicksort_records(records, pivotIndex + 1, high);
+VaccinationRecord* nextRecord(RecordCursor *cursor) {
+	RecordLog *log;
+	VaccinationRecord *best = NULL;
+	unsigned long long best_seq = 0;
+	int i, position, best_shard = 0;
+	for (i = 0; i < cursor->shard_count; i++) {
+		log = &cursor->shards[i]->log;
+		position = cursor->positions[i];
+		while (position < log->count && log->records[position] == NULL) 
+			position++;
+		cursor->positions[i] = position;
+		if (position == log->count) continue;
+		if (best == NULL || log->seqs[position] < best_seq) {
+			best = log->records[position];
+			best_seq = log->seqs[position];
+			best_shard = i;
+		}
 	}
+	if (best != NULL) cursor->positions[best_shard]++;
+	return best;
 }
 
 /**
- * @brief Imprime um registro de vacinação.
+ * @brief Conta os registros de vacinação de todas as partições.
  * 
- * @param record O registro de vacinação a ser impresso.
+ * @param shards As partições dos registros de vacinação.
+ * @param shard_count O número de partições.
+ * 
+ * @return O número de registros.
  */
-void print_record(VaccinationRecord *record) {
-	printf("%s %s %02d-%02d-%04d\n", 
-		record->user_name, record->batch_id, 
-		record->vaccination_date->day, 
-		record->vaccination_date->month, 
-		record->vaccination_date->year);
+size_t countAllRecords(VaccinationRecordsHashtable **shards, 
+	int shard_count) {
+	size_t count = 0;
+	int i;
+	for (i = 0; i < shard_count; i++) 
+		count += (size_t)shards[i]->all_records_count;
+	return count;
 }
 
 /**
- * @brief Lista todos os registros de vacinação no sistema.
+ * @brief Intercala os registros de várias partições pela ordenação radix 
+ * dos seus números de sequência, em tempo linear no número de registros.
+ * As chaves vêm da coluna dos números de sequência de cada partição. O 
+ * número de sequência é só um contador crescente, sem a data; basta, 
+ * porque a data de vacinação é a data atual, que nunca recua.
  * 
- * @param vaccinationSystem Tabela de hash com os registros de vacinação.
+ * @param shards As partições dos registros de vacinação.
+ * @param shard_count O número de partições.
+ * @param records O vetor, com espaço para todos os registros.
  * 
- * @return 1 se a operação for bem-sucedida, 0 caso contrário.
+ * @return 1 em caso de sucesso, 0 se faltar memória.
  */
-int listAllRecordsInSystem(VaccinationRecordsHashtable* vaccinationSystem) {
-	VaccinationRecord **all_records = NULL;
-	VaccinationRecordsUser *user;
-	int i, j, index, sys_records_num;
-	sys_records_num = vaccinationSystem->all_records_count;
-	all_records = (VaccinationRecord**)malloc(
-		sizeof(VaccinationRecord*) * sys_records_num);
-	if (all_records == NULL) return 0;
-	index  = 0;
-	for (i = 0; i < vaccinationSystem->size; i++) {
-		user = vaccinationSystem->vaccination_records[i];
-		while (user != NULL) {
-			for (j = 0; j < user->record_count; j++) {
-				all_records[index++] = user->records[j];
+int sortAllRecords(VaccinationRecordsHashtable **shards, int shard_count, 
+	VaccinationRecord **records) {
+	size_t count = 0, j, total = countAllRecords(shards, shard_count);
+	RadixItem *items = malloc(sizeof(RadixItem) * (total > 0 ? total : 1));
+	RecordLog *log;
+	int i, k;
+	if (items == NULL) return 0;
+	for (i = 0; i < shard_count; i++) {
+		log = &shards[i]->log;
+		for (k = 0; k < log->count; k++)
+			if (log->records[k] != NULL) {
+				items[count].key = log->seqs[k];
+				items[count++].value = log->records[k];
 			}
-			user = user->next;
-		}
 	}
-	quicksort_records(all_records, 0, sys_records_num - 1);
-	for (i = 0; i < sys_records_num; i++)
-		print_record(all_records[i]);
-		
-	free(all_records);
+	if (!radixSort(items, count)) {
+		free(items);
+		return 0;
+	}
+	for (j = 0; j < count; j++) records[j] = items[j].value;
+	free(items);
 	return 1;
 }
 
+/**
+ * @brief Copia para um vetor os ponteiros de todos os registros de 
+ * vacinação das partições, por ordem cronológica. Com várias partições, 
+ * os registros são ordenados pelo número de sequência, ou intercalados 
+ * pelo cursor se faltar memória para a ordenação.
+ * 
+ * @param shards As partições dos registros de vacinação.
+ * @param shard_count O número de partições.
+ * @param records O vetor, com espaço para todos os registros.
+ */
+void collectAllRecords(VaccinationRecordsHashtable **shards, 
+	int shard_count, VaccinationRecord **records) {
+	RecordLog *log = &shards[0]->log;
+	RecordCursor cursor;
+	VaccinationRecord *record;
+	int i, count = 0;
+	if (shard_count == 1) {
+		for (i = 0; i < log->count; i++)
+			if (log->records[i] != NULL) 
+				records[count++] = log->records[i];
+		return;
+	}
+	if (sortAllRecords(shards, shard_count, records)) return;
+	initRecordCursor(&cursor, shards, shard_count);
+	while ((record = nextRecord(&cursor)) != NULL) 
+		records[count++] = record;
+}
+
+/**
+ * @brief Lista todos os registros de vacinação no sistema, por ordem 
+ * cronológica de aplicação. Como a data de vacinação é sempre a data atual, 
+ * que nunca recua, a ordem de criação do registro cronológico já é a ordem 
+ * por data e número de sequência, bastando ignorar os registros apagados; 
+ * com várias partições, os seus registros cronológicos são ordenados pelo 
+ * número de sequência, ou intercalados pelo cursor se faltar memória.
+ * 
+ * @param shards As partições dos registros de vacinação.
+ * @param shard_count O número de partições.
+ * @param out O escritor de saída onde os registros são impressos.
+ */
+void listAllRecordsInSystem(VaccinationRecordsHashtable **shards, 
+	int shard_count, Output *out) {
+	RecordLog *log = &shards[0]->log;
+	size_t count = countAllRecords(shards, shard_count), j;
+	VaccinationRecord **records;
+	RecordCursor cursor;
+	VaccinationRecord *record;
+	int i;
+	if (shard_count == 1) {
+		for (i = 0; i < log->count; i++)
+			if (log->records[i] != NULL) 
+				print_record(out, log->records[i]);
+		return;
+	}
+	records = malloc(sizeof(VaccinationRecord*) * (count > 0 ? count : 1));
+	if (records != NULL && sortAllRecords(shards, shard_count, records)) {
+		for (j = 0; j < count; j++) print_record(out, records[j]);
+		free(records);
+		return;
+	}
+	free(records);
+	initRecordCursor(&cursor, shards, shard_count);
+	while ((record = nextRecord(&cursor)) != NULL)
+		print_record(out, record);
+}
+
 /**
  * @brief Lista todos os registros de vacinação de um usuário no sistema.
  * 
  * @param vaccinationSystem Tabela de hash com os registros de vacinação.
+ * @param out O escritor de saída onde os registros são impressos.
  * @param name Nome do usuário.
  */
 void listAllUserRecordsInSystem(VaccinationRecordsHashtable *vaccinationSystem, 
-	const char *name) {
+	Output *out, const char *name) {
 	VaccinationRecordsUser *user;
 	user = findUser(vaccinationSystem, name);
 	for (int i = 0; i < user->record_count; i++)
-		print_record(user->records[i]);
+		print_record(out, user->records[i]);
 }
 
 /**
@@ -406,54 +568,179 @@ void listAllUserRecordsInSystem(VaccinationRecordsHashtable *vaccinationSystem,
  * @param record O registro de vacinação a ser liberado.
  */
 void freeVaccinationRecord(VaccinationRecord* record) {
-	if (record != NULL) {
-		free(record->user_name);
-		free(record->vaccine_name);
-		free(record->batch_id);
-		free(record->vaccination_date);
-		free(record);
+	free(record);
+}
+
+/**
+ * @brief Libera um registro de vacinação retirado.
+ * 
+ * @param entry O registro de vacinação (VaccinationRecord) a liberar.
+ */
+void freeRecordEntry(void *entry) {
+	freeVaccinationRecord((VaccinationRecord*)entry);
+}
+
+/**
+ * @brief Libera a lista de registros de um usuário, se já não estiver 
+ * embutida na estrutura do usuário. Os registros não são liberados.
+ * 
+ * @param user O usuário.
+ */
+void freeUserRecords(VaccinationRecordsUser *user) {
+	if (user->records != user->inline_records) free(user->records);
+}
+
+/**
+ * @brief Libera um usuário, sem os seus registros de vacinação.
+ * 
+ * @param user O usuário.
+ */
+void freeUser(VaccinationRecordsUser *user) {
+	destroyRecordSet(&user->vaccinations);
+	freeUserRecords(user);
+	free(user->user);
+	free(user);
+}
+
+/**
+ * @brief Libera um usuário retirado.
+ * 
+ * @param entry O usuário (VaccinationRecordsUser) a liberar.
+ */
+void freeUserEntry(void *entry) {
+	freeUser((VaccinationRecordsUser*)entry);
+}
+
+/**
+ * @brief Apaga um registro de vacinação, deixando a sua posição no registro 
+ * cronológico vazia. O registro só é liberado quando nenhum relatório em 
+ * curso o puder ver.
+ * 
+ * @param ht Tabela de hash de registros de vacinação.
+ * @param record O registro de vacinação a apagar.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória, caso em que o registro
+ * fica no registro cronológico.
+ */
+int retireVaccinationRecord(VaccinationRecordsHashtable *ht, 
+	VaccinationRecord *record) {
+	int index = record->log_index;
+	ht->log.records[index] = NULL;
+	ht->all_records_count--;
+	if (retireObject(&ht->retired, record, freeRecordEntry)) return 1;
+	ht->log.records[index] = record;
+	ht->all_records_count++;
+	return 0;
+}
+
+/**
+ * @brief Apaga um registro de um usuário que continua no sistema, 
+ * retirando também o seu par (vacina, data) do conjunto do usuário.
+ * 
+ * @param ht Tabela de hash de registros de vacinação.
+ * @param user O usuário dono do registro.
+ * @param record O registro de vacinação a apagar.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+int retireUserRecord(VaccinationRecordsHashtable *ht, 
+	VaccinationRecordsUser *user, VaccinationRecord *record) {
+	int vaccine_id = record->vaccine_id;
+	Date date = record->vaccination_date;
+	if (!retireVaccinationRecord(ht, record)) return 0;
+	recordSetRemove(&user->vaccinations, vaccine_id, date);
+	return 1;
+}
+
+/**
+ * @brief Compacta o registro cronológico quando as posições vazias são 
+ * mais de metade das ocupadas, mantendo a ordem dos registros em todas as 
+ * colunas.
+ * 
+ * @param ht Tabela de hash de registros de vacinação.
+ */
+void compactRecordLog(VaccinationRecordsHashtable *ht) {
+	RecordLog *log = &ht->log;
+	int i, count = 0;
+	if (log->count - ht->all_records_count <= log->count / 2) return;
+	for (i = 0; i < log->count; i++) {
+		if (log->records[i] == NULL) continue;
+		log->records[i]->log_index = count;
+		log->seqs[count] = log->seqs[i];
+		log->records[count++] = log->records[i];
 	}
+	log->count = count;
 }
 
 /**
- * @brief Exclui todos os registros de vacinação de um usuário do sistema.
+ * @brief Exclui todos os registros de vacinação de um usuário do sistema. O 
+ * usuário, de onde os registros leem o nome, é retirado depois deles. O 
+ * espaço das retiradas é reservado antes de alterar a tabela, pelo que 
+ * nenhuma falha a meio.
  * 
  * @param ht Tabela de hash de registros de vacinação.
  * @param user_name Nome do usuário.
  * 
- * @return O número de registros excluídos.
+ * @return O número de registros excluídos, ou RECORD_NO_MEMORY se faltar 
+ * memória, caso em que nada é excluído.
  */
 int deleteRecordVaccinationRecordsUser(VaccinationRecordsHashtable *ht, 
 	const char *user_name) {
-	VaccinationRecordsUser *prev, *curr;
-	int deleted = 0;
-	unsigned int index = hash_user(user_name, ht->size);
-	prev = NULL;
-	curr = ht->vaccination_records[index];
-	while (curr) {
-		if (strcmp(curr->user, user_name) == 0) {
-			for (int i = 0; i < curr->record_count; i++) {
-				freeVaccinationRecord(curr->records[i]);
-				ht->all_records_count--;
-				deleted++;
-			}
-			if (prev) prev->next = curr->next;
-			else ht->vaccination_records[index] = curr->next;
-			free(curr->records);
-			free(curr->user);
-			free(curr);
-			break;
-		}
-		prev = curr;
-		curr = curr->next;
+	VaccinationRecordsUser *user;
+	int i, deleted = 0;
+	user = findUser(ht, user_name);
+	if (user == NULL) return 0;
+	if (!reserveRetired(&ht->retired, user->record_count + 1)) 
+		return RECORD_NO_MEMORY;
+	hashTableRemove(&ht->users, user_name);
+	for (i = 0; i < user->record_count; i++) {
+		retireVaccinationRecord(ht, user->records[i]);
+		deleted++;
 	}
-	ht->users_count--;
-	if ((float)ht->users_count / ht->size < (1-MAX_LOAD_FACTOR))
-		if (resizeVaccinationRecordsHashtable(ht, 
-			nextPrime(ht->size/2)) == 0) return 0;
+	retireObject(&ht->retired, user, freeUserEntry);
+	compactRecordLog(ht);
 	return deleted;
 }
 
+/**
+ * @brief Apaga os registros de um usuário com a data indicada e, se for 
+ * dado, com o lote indicado. Os registros dessa data são contíguos na lista
+ * ordenada, pelo que são encontrados por pesquisa binária e a lista é 
+ * compactada no lugar.
+ * 
+ * @param ht Tabela de hash de registros de vacinação.
+ * @param user O usuário.
+ * @param vaccination_date Data da vacinação.
+ * @param batch_id Identificação do lote, ou NULL para qualquer lote.
+ * 
+ * @return O número de registros excluídos, ou RECORD_NO_MEMORY se faltar 
+ * memória, caso em que nada é excluído.
+ */
+int deleteUserRecords(VaccinationRecordsHashtable *ht, 
+	VaccinationRecordsUser *user, Date vaccination_date, 
+	const char *batch_id) {
+	VaccinationRecord *record;
+	int i, kept, first, last;
+	first = userRecordsBound(user, vaccination_date, 0);
+	last = userRecordsBound(user, vaccination_date, 1);
+	if (!reserveRetired(&ht->retired, last - first)) 
+		return RECORD_NO_MEMORY;
+	for (i = kept = first; i < last; i++) {
+		record = user->records[i];
+		if (batch_id == NULL || 
+			strcmp(record->batch->batch, batch_id) == 0)
+			retireUserRecord(ht, user, record);
+		else user->records[kept++] = record;
+	}
+	memmove(&user->records[kept], &user->records[last], 
+		sizeof(VaccinationRecord*) * (user->record_count - last));
+	memmove(&user->dates[kept], &user->dates[last], 
+		sizeof(Date) * (user->record_count - last));
+	user->record_count -= last - kept;
+	compactRecordLog(ht);
+	return last - kept;
+}
+
 /**
  * @brief Exclui um registro de vacinação de um usuário com base na data.
  * 
@@ -461,30 +748,18 @@ int deleteRecordVaccinationRecordsUser(VaccinationRecordsHashtable *ht,
  * @param user_name Nome do usuário.
  * @param vaccination_date Data da vacinação.
  * 
- * @return O número de registros excluídos.
+ * @return O número de registros excluídos, ou RECORD_NO_MEMORY se faltar 
+ * memória.
  */
 int deleteRecordByNameAndDate(VaccinationRecordsHashtable *ht, 
 	const char *user_name, Date vaccination_date) {
 	VaccinationRecordsUser *user;
+	int deleted;
 	user = findUser(ht, user_name);
-	int count = 0, deleted = 0;
-	VaccinationRecord **new_records = (VaccinationRecord **)malloc(
-		sizeof(VaccinationRecord*) * user->record_count);
-	if (new_records == NULL) return -1;
-	for (int i = 0; i < user->record_count; i++) {
-		if (compareDate1Date2(user->records[i]->vaccination_date, 
-			vaccination_date) == 0) {
-			freeVaccinationRecord(user->records[i]);
-			ht->all_records_count--;
-			deleted++;
-		} 
-		else new_records[count++] = user->records[i];
-	}
-	free(user->records);
-	user->records = new_records;
-	user->record_count = count;
-	if (user->record_count == 0) deleteRecordVaccinationRecordsUser(ht, 
-		user_name);
+	deleted = deleteUserRecords(ht, user, vaccination_date, NULL);
+	if (deleted != RECORD_NO_MEMORY && user->record_count == 0 && 
+		deleteRecordVaccinationRecordsUser(ht, user_name) == 
+		RECORD_NO_MEMORY) return RECORD_NO_MEMORY;
 	return deleted;
 }
 
@@ -497,33 +772,35 @@ int deleteRecordByNameAndDate(VaccinationRecordsHashtable *ht,
  * @param vaccination_date Data da vacinação.
  * @param batch_id Identificação do lote.
  * 
- * @return O número de registros excluídos.
+ * @return O número de registros excluídos, ou RECORD_NO_MEMORY se faltar 
+ * memória.
  */
 int deleteRecordByNameDateAndBatchID(VaccinationRecordsHashtable *ht, 
 	const char *user_name, Date vaccination_date, const char *batch_id) {
 	VaccinationRecordsUser *user;
-	int count = 0, deleted = 0;
+	int deleted;
 	user = findUser(ht, user_name);
-	VaccinationRecord **new_records = (VaccinationRecord **)malloc(
-		sizeof(VaccinationRecord*) * user->record_count);
-	if (new_records == NULL) return -1;
-	for (int i = 0; i < user->record_count; i++) {
-		if (compareDate1Date2(user->records[i]->vaccination_date, 
-			vaccination_date) == 0 &&
-			strcmp(user->records[i]->batch_id, batch_id) == 0) {
-			freeVaccinationRecord(user->records[i]);
-			ht->all_records_count--;
-			deleted++;
-		} else new_records[count++] = user->records[i];
-	}
-	free(user->records);
-	user->records = new_records;
-	user->record_count = count;
-	if (user->record_count == 0) 
-		deleteRecordVaccinationRecordsUser(ht, user_name);
+	deleted = deleteUserRecords(ht, user, vaccination_date, batch_id);
+	if (deleted != RECORD_NO_MEMORY && user->record_count == 0 && 
+		deleteRecordVaccinationRecordsUser(ht, user_name) == 
+		RECORD_NO_MEMORY) return RECORD_NO_MEMORY;
 	return deleted;
 }
 
+/**
+ * @brief Libera um usuário guardado na tabela de hash, com todos os seus 
+ * registros de vacinação.
+ * 
+ * @param entry O usuário (VaccinationRecordsUser) a liberar.
+ */
+void freeVaccinationRecordsUser(void *entry) {
+	VaccinationRecordsUser *user = (VaccinationRecordsUser*)entry;
+	int i;
+	for (i = 0; i < user->record_count; i++)
+		freeVaccinationRecord(user->records[i]);
+	freeUser(user);
+}
+
 /**
  * @brief Libera a memória utilizada pela tabela de hash de registros de 
  * vacinação.
@@ -531,21 +808,11 @@ int deleteRecordByNameDateAndBatchID(VaccinationRecordsHashtable *ht,
  * @param ht Tabela de hash de registros de vacinação.
  */
 void destroyVaccinationRecordsHashtable(VaccinationRecordsHashtable *ht) {
-	int i, j;
-	VaccinationRecordsUser *user, *temp;
-	if (ht == NULL || ht->vaccination_records == NULL) return;
-	for (i = 0; i < ht->size; i++) {
-		user = ht->vaccination_records[i];
-		while (user) {
-			for (j = 0; j < user->record_count; j++)
-				freeVaccinationRecord(user->records[j]);
-			free(user->records);
-			free(user->user);
-			temp = user;
-			user = user->next;
-			free(temp);
-		}
-	}
-	free(ht->vaccination_records);
+	if (ht == NULL) return;
+	destroyRetireList(&ht->retired);
+	hashTableForEach(&ht->users, freeVaccinationRecordsUser);
+	destroyHashTable(&ht->users);
+	free(ht->log.seqs);
+	free(ht->log.records);
 	free(ht);
 }
@@ -10,19 +10,59 @@
 #define RECORDS_H
 
 #include "string.h"
+#include "constants.h"
 #include "date.h"
+#include "hashtable.h"
+#include "recordset.h"
+#include "output.h"
+#include "epoch.h"
+
+/** Número de registros de um usuário a partir do qual a verificação de 
+ * vacinação repetida usa o conjunto de pares (vacina, data) em vez de 
+ * percorrer os registros */
+#define RECORD_SET_MIN_RECORDS 8
+
+/** Número de registros de um usuário guardados dentro da própria estrutura
+ * do usuário, sem vetor alocado à parte */
+#define USER_INLINE_RECORDS 3
+
+/** Resultado das exclusões de registros que ficaram sem memória */
+#define RECORD_NO_MEMORY -2
+
+struct BatchInfo;
+struct VaccinationRecordsUser;
 
 /**
- * Estrutura que representa um registro de vacinação de um usuário
+ * Estrutura que representa um registro de vacinação de um usuário, de 
+ * tamanho fixo e numa única alocação: os nomes do usuário e do lote são 
+ * lidos das estruturas a que o registro se refere
  */
 typedef struct VaccinationRecord {
-    int record_id; /** ID único do registro de vacinação */
-    char *user_name; /** Nome do usuário que recebeu a vacina */
-    char *vaccine_name; /** Nome da vacina administrada */
-    char *batch_id; /** Identificador do lote da vacina */
+    unsigned long long seq; /** Número de sequência único e crescente do 
+    registro de vacinação */
+    struct VaccinationRecordsUser *user; /** Usuário que recebeu a vacina, 
+    dono do registro */
+    struct BatchInfo *batch; /** Lote da vacina; um lote com aplicações 
+    nunca é removido do sistema, apenas fica sem doses */
+    int log_index; /** Posição do registro no registro cronológico */
+    int vaccine_id; /** ID da vacina administrada no catálogo de vacinas */
     Date vaccination_date; /** Data da vacinação */
 } VaccinationRecord;
 
+/**
+ * Estrutura que representa o registro cronológico por colunas: a mesma 
+ * posição de cada vetor diz respeito ao mesmo registro, para que as 
+ * passagens por todos os registros leiam só as colunas de que precisam, 
+ * contíguas em memória
+ */
+typedef struct RecordLog {
+    unsigned long long *seqs; /** Números de sequência dos registros */
+    VaccinationRecord **records; /** Registros de vacinação, a NULL nas 
+    posições apagadas até à compactação seguinte */
+    int count; /** Número de posições ocupadas */
+    int capacity; /** Capacidade alocada de cada coluna */
+} RecordLog;
+
 /**
  * Estrutura que representa um conjunto de registros de vacinação de um usuário
  */
@@ -38,10 +78,19 @@ typedef struct VaccinationRecords {
  */
 typedef struct VaccinationRecordsUser {
     char *user; /** Nome do usuário */
-    VaccinationRecord **records; /** Lista de registros de 
-    vacinação do usuário */
+    VaccinationRecord **records; /** Lista de registros de vacinação do 
+    usuário, ordenada por data; aponta para `inline_records` até deixar de 
+    caber nele */
+    Date *dates; /** Datas dos registros, pela ordem da lista, na mesma 
+    alocação; as pesquisas por data não leem os registros */
+    VaccinationRecord *inline_records[USER_INLINE_RECORDS]; /** Espaço para 
+    os primeiros registros, sem alocação própria */
+    Date inline_dates[USER_INLINE_RECORDS]; /** Datas dos registros de 
+    `inline_records` */
     int record_count; /** Número de registros de vacinação do usuário */
-    struct VaccinationRecordsUser *next; /** Ponteiro para o próximo usuário */
+    int record_capacity; /** Capacidade da lista de registros */
+    RecordSet vaccinations; /** Pares (vacina, data) dos registros do 
+    usuário, criado só a partir de RECORD_SET_MIN_RECORDS registros */
 } VaccinationRecordsUser;
 
 /**
@@ -49,25 +98,64 @@ typedef struct VaccinationRecordsUser {
  * vacinação
  */
 typedef struct VaccinationRecordsHashtable {
-    VaccinationRecordsUser **vaccination_records; /** Tabela hash para armazenar
-    os registros de usuários */
-    int users_count; /** Número de usuários cadastrados no sistema */
+    HashTable users; /** Tabela hash dos usuários (VaccinationRecordsUser),
+    indexada pelo nome */
     int all_records_count; /** Número total de registros de vacinação */
-    int size; /** Tamanho da tabela hash */
+    RecordLog log; /** Registro cronológico só de acréscimo com todos os 
+    registros de vacinação, pela ordem de criação */
+    unsigned long long next_seq; /** Número de sequência do próximo 
+    registro inserido, dado pelo sistema */
+    RetireList retired; /** Registros apagados que ainda podem estar a ser 
+    lidos por um relatório em curso */
 } VaccinationRecordsHashtable;
 
+/**
+ * Estrutura que percorre os registros de vacinação de várias partições pela
+ * ordem global de criação, intercalando os registros cronológicos de cada 
+ * uma pelo número de sequência
+ */
+typedef struct RecordCursor {
+    VaccinationRecordsHashtable **shards; /** Partições percorridas */
+    int shard_count; /** Número de partições */
+    int positions[MAX_SHARDS]; /** Próxima posição a ver no registro 
+    cronológico de cada partição */
+} RecordCursor;
+
 VaccinationRecordsHashtable* initVaccinationRecordsHashtable();
 
 int insertVaccinationRecord(VaccinationRecordsHashtable *ht, 
-const char *user_name, const char *vaccine_name, const char* batch_id, 
-Date vaccination_date);
+const char *user_name, struct BatchInfo *batch, Date vaccination_date);
+
+int restoreVaccinationRecord(VaccinationRecordsHashtable *ht, 
+const char *user_name, struct BatchInfo *batch, Date vaccination_date, 
+unsigned long long seq);
+
+VaccinationRecordsUser *findUser(VaccinationRecordsHashtable *ht, 
+const char *user_name);
+
+int userExistInSystem(VaccinationRecordsHashtable *ht, const char* user);
+
+void print_record(Output *out, VaccinationRecord *record);
+
+size_t countAllRecords(VaccinationRecordsHashtable **shards, 
+int shard_count);
+
+int sortAllRecords(VaccinationRecordsHashtable **shards, int shard_count, 
+VaccinationRecord **records);
+
+void collectAllRecords(VaccinationRecordsHashtable **shards, 
+int shard_count, VaccinationRecord **records);
+
+void initRecordCursor(RecordCursor *cursor, 
+VaccinationRecordsHashtable **shards, int shard_count);
 
-int userExistInSystem(VaccinationRecordsHashtable *ht, char* user);
+VaccinationRecord* nextRecord(RecordCursor *cursor);
 
-int listAllRecordsInSystem(VaccinationRecordsHashtable* vaccinationSystem);
+void listAllRecordsInSystem(VaccinationRecordsHashtable **shards, 
+int shard_count, Output *out);
 
 void listAllUserRecordsInSystem(VaccinationRecordsHashtable *vaccinationSystem, 
-const char *name);
+Output *out, const char *name);
 
 int deleteRecordVaccinationRecordsUser(VaccinationRecordsHashtable *ht, 
 const char *user_name);
@@ -0,0 +1,159 @@
+/**
+ * @file recordset.c
+ * @author Diogo Lobo (ist1109293)
+ * @brief Implementação do conjunto de pares (vacina, data) dos registros de
+ * um usuário.
+ * @date 2026-10-16
+ */
+
+#include <stdlib.h>
+#include "recordset.h"
+
+/** Multiplicador de Fibonacci usado para dispersar os pares. */
+#define RECORD_SET_MULTIPLIER 0x9e3779b97f4a7c15ull
+
+/**
+ * @brief Junta um par (vacina, data) num único inteiro, nunca 0.
+ * 
+ * @param vaccine_id O ID da vacina no catálogo.
+ * @param date A data.
+ * 
+ * @return O par codificado.
+ */
+uint64_t recordSetKey(int vaccine_id, Date date) {
+	return ((uint64_t)(unsigned int)vaccine_id + 1) << 32 | date;
+}
+
+/**
+ * @brief Calcula a posição ideal de um par no conjunto.
+ * 
+ * @param set O conjunto.
+ * @param key O par codificado.
+ * 
+ * @return A posição ideal.
+ */
+unsigned int recordSetHome(const RecordSet *set, uint64_t key) {
+	return (unsigned int)((key * RECORD_SET_MULTIPLIER) >> 32) & 
+		(set->capacity - 1);
+}
+
+/**
+ * @brief Inicializa um conjunto vazio, ainda sem tabela.
+ * 
+ * @param set O conjunto a inicializar.
+ */
+void initRecordSet(RecordSet *set) {
+	set->keys = NULL;
+	set->capacity = set->count = 0;
+}
+
+/**
+ * @brief Procura a posição de um par, ou a posição livre onde ficaria.
+ * 
+ * @param set O conjunto, com tabela.
+ * @param key O par codificado.
+ * 
+ * @return A posição encontrada.
+ */
+unsigned int recordSetSlot(const RecordSet *set, uint64_t key) {
+	unsigned int i = recordSetHome(set, key), mask = set->capacity - 1;
+	while (set->keys[i] != 0 && set->keys[i] != key) i = (i + 1) & mask;
+	return i;
+}
+
+/**
+ * @brief Verifica se um par pertence ao conjunto.
+ * 
+ * @param set O conjunto.
+ * @param vaccine_id O ID da vacina.
+ * @param date A data.
+ * 
+ * @return 1 se o par pertence ao conjunto, 0 caso contrário.
+ */
+int recordSetContains(const RecordSet *set, int vaccine_id, Date date) {
+	uint64_t key = recordSetKey(vaccine_id, date);
+	if (set->count == 0) return 0;
+	return set->keys[recordSetSlot(set, key)] == key;
+}
+
+/**
+ * @brief Muda a capacidade do conjunto, recolocando todos os pares.
+ * 
+ * @param set O conjunto.
+ * @param capacity A nova capacidade, potência de dois.
+ * 
+ * @return 1 em caso de sucesso, 0 se a alocação falhar.
+ */
+int resizeRecordSet(RecordSet *set, unsigned int capacity) {
+	uint64_t *old_keys = set->keys;
+	unsigned int i, old_capacity = set->capacity;
+	set->keys = (uint64_t*)calloc(capacity, sizeof(uint64_t));
+	if (set->keys == NULL) {
+		set->keys = old_keys;
+		return 0;
+	}
+	set->capacity = capacity;
+	for (i = 0; i < old_capacity; i++)
+		if (old_keys[i] != 0)
+			set->keys[recordSetSlot(set, old_keys[i])] = 
+				old_keys[i];
+	free(old_keys);
+	return 1;
+}
+
+/**
+ * @brief Acrescenta um par ao conjunto, que ainda não o pode conter. A 
+ * tabela é criada no primeiro par e duplicada quando fica meio cheia.
+ * 
+ * @param set O conjunto.
+ * @param vaccine_id O ID da vacina.
+ * @param date A data.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+int recordSetAdd(RecordSet *set, int vaccine_id, Date date) {
+	uint64_t key = recordSetKey(vaccine_id, date);
+	unsigned int capacity = set->capacity ? set->capacity * 2 : 
+		RECORD_SET_MIN_CAPACITY;
+	if (2 * (set->count + 1) > set->capacity && 
+		!resizeRecordSet(set, capacity)) return 0;
+	set->keys[recordSetSlot(set, key)] = key;
+	set->count++;
+	return 1;
+}
+
+/**
+ * @brief Retira um par do conjunto, se existir. Os pares seguintes da mesma
+ * sequência que possam ocupar a posição libertada recuam para ela, pelo que
+ * não ficam marcas de posições apagadas.
+ * 
+ * @param set O conjunto.
+ * @param vaccine_id O ID da vacina.
+ * @param date A data.
+ */
+void recordSetRemove(RecordSet *set, int vaccine_id, Date date) {
+	uint64_t key = recordSetKey(vaccine_id, date);
+	unsigned int i, next, home, mask = set->capacity - 1;
+	if (set->count == 0) return;
+	i = recordSetSlot(set, key);
+	if (set->keys[i] != key) return;
+	for (next = (i + 1) & mask; set->keys[next] != 0; 
+		next = (next + 1) & mask) {
+		home = recordSetHome(set, set->keys[next]);
+		if (((next - home) & mask) < ((next - i) & mask)) continue;
+		set->keys[i] = set->keys[next];
+		i = next;
+	}
+	set->keys[i] = 0;
+	set->count--;
+}
+
+/**
+ * @brief Libera a tabela do conjunto.
+ * 
+ * @param set O conjunto.
+ */
+void destroyRecordSet(RecordSet *set) {
+	free(set->keys);
+	initRecordSet(set);
+}
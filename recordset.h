@@ -0,0 +1,38 @@
+/**
+ * @file recordset.h
+ * @author Diogo Lobo (ist1109293)
+ * @brief Cabeçalho do conjunto de pares (vacina, data) dos registros de um 
+ * usuário. Cada par é guardado como um único inteiro de 64 bits numa tabela
+ * de endereçamento aberto com sondagem linear, o que torna constante o 
+ * tempo de verificar se o usuário já foi vacinado com uma vacina numa data.
+ * @date 2026-10-16
+ */
+
+#ifndef RECORDSET_H
+#define RECORDSET_H
+
+#include <stdint.h>
+#include "date.h"
+
+/** Capacidade inicial do conjunto, potência de dois. */
+#define RECORD_SET_MIN_CAPACITY 16
+
+/** Estrutura que representa o conjunto de pares (vacina, data) de um 
+ * usuário. Sem capacidade, o conjunto ainda não foi criado. */
+typedef struct RecordSet {
+    uint64_t *keys; /** Posições da tabela; 0 marca uma posição livre. */
+    unsigned int capacity; /** Número de posições, potência de dois. */
+    unsigned int count; /** Número de pares guardados. */
+} RecordSet;
+
+void initRecordSet(RecordSet *set);
+
+int recordSetContains(const RecordSet *set, int vaccine_id, Date date);
+
+int recordSetAdd(RecordSet *set, int vaccine_id, Date date);
+
+void recordSetRemove(RecordSet *set, int vaccine_id, Date date);
+
+void destroyRecordSet(RecordSet *set);
+
+#endif
@@ -0,0 +1,320 @@
+/**
+ * @file report.c
+ * @author Diogo Lobo (ist1109293)
+ * @brief Implementação dos relatórios concorrentes.
+ * @date 2026-10-16
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "report.h"
+
+/**
+ * @brief Escolhe o número de threads dos relatórios: uma por processador 
+ * disponível além da principal, pelo menos uma e até REPORT_MAX_THREADS.
+ * 
+ * @return O número de threads.
+ */
+int reportThreadCount() {
+	long count = sysconf(_SC_NPROCESSORS_ONLN) - 1;
+	if (count < 1) return 1;
+	if (count > REPORT_MAX_THREADS) return REPORT_MAX_THREADS;
+	return (int)count;
+}
+
+/**
+ * @brief Atualiza a época a partir da qual os objetos retirados ainda têm 
+ * de ser guardados: a do relatório mais antigo ainda por formatar. Um 
+ * relatório cuja formatação ficou sem memória continua a contar, porque é 
+ * impresso das suas linhas pela thread principal. Chamada com o lock.
+ * 
+ * @param pool O conjunto dos relatórios.
+ */
+void updateSafeEpoch(ReportPool *pool) {
+	EpochClock *clock = &pool->vs->epochs;
+	Report *report = pool->first;
+	while (report != NULL && report->done && !report->out.failed)
+		report = report->next;
+	atomic_store(&clock->safe, report != NULL ? report->epoch : 
+		atomic_load(&clock->current));
+}
+
+/**
+ * @brief Formata as linhas de um relatório na sua saída em memória.
+ * 
+ * @param report O relatório.
+ */
+void writeReport(Report *report) {
+	VaccinationRecord **records = (VaccinationRecord**)report->rows;
+	BatchView *batches = (BatchView*)report->rows;
+	size_t i;
+	if (!initMemoryOutput(&report->out, report->count * 32 + 1)) {
+		report->out.failed = 1;
+		return;
+	}
+	for (i = 0; i < report->count && !report->out.failed; i++)
+		if (report->kind == 'l') 
+			printBatchView(&report->out, &batches[i]);
+		else print_record(&report->out, records[i]);
+}
+
+/**
+ * @brief Ciclo de uma thread dos relatórios: formata os relatórios pela 
+ * ordem em que foram pedidos, até o conjunto ser parado.
+ * 
+ * @param arg O conjunto dos relatórios (ReportPool).
+ * 
+ * @return NULL.
+ */
+void* reportWorkerMain(void *arg) {
+	ReportPool *pool = (ReportPool*)arg;
+	Report *report;
+	pthread_mutex_lock(&pool->lock);
+	while (1) {
+		while (pool->next_job == NULL && !pool->stop)
+			pthread_cond_wait(&pool->work_ready, &pool->lock);
+		if (pool->next_job == NULL) break;
+		report = pool->next_job;
+		pool->next_job = report->next;
+		pthread_mutex_unlock(&pool->lock);
+		writeReport(report);
+		pthread_mutex_lock(&pool->lock);
+		report->done = 1;
+		updateSafeEpoch(pool);
+		pthread_cond_broadcast(&pool->work_done);
+	}
+	pthread_mutex_unlock(&pool->lock);
+	return NULL;
+}
+
+/**
+ * @brief Imprime as linhas de um relatório diretamente no fluxo, quando a 
+ * sua formatação ficou sem memória.
+ * 
+ * @param stream O fluxo da saída.
+ * @param report O relatório.
+ */
+void printReportRows(FILE *stream, Report *report) {
+	VaccinationRecord **records = (VaccinationRecord**)report->rows;
+	BatchView *view = (BatchView*)report->rows;
+	size_t i;
+	for (i = 0; i < report->count; i++, view++)
+		if (report->kind == 'l')
+			fprintf(stream, "%s %s %02d-%02d-%04d %d %d\n", 
+				view->vaccine_name, view->batch->batch, 
+				dateDay(view->batch->date), 
+				dateMonth(view->batch->date), 
+				dateYear(view->batch->date), view->available, 
+				view->applications);
+		else fprintf(stream, "%s %s %02d-%02d-%04d\n", 
+			records[i]->user->user, records[i]->batch->batch, 
+			dateDay(records[i]->vaccination_date), 
+			dateMonth(records[i]->vaccination_date), 
+			dateYear(records[i]->vaccination_date));
+}
+
+/**
+ * @brief Libera um relatório já escrito.
+ * 
+ * @param report O relatório.
+ */
+void freeReport(Report *report) {
+	free(report->rows);
+	free(report->prefix);
+	free(report->out.buffer);
+	free(report);
+}
+
+/**
+ * @brief Escreve o relatório mais antigo: a saída que o antecede e, depois 
+ * de a formatação terminar, a do próprio relatório.
+ * 
+ * @param pool O conjunto dos relatórios.
+ * @param stream O fluxo da saída.
+ */
+void emitReport(ReportPool *pool, FILE *stream) {
+	Report *report = pool->first;
+	if (report->prefix_length > 0)
+		fwrite(report->prefix, 1, report->prefix_length, stream);
+	pthread_mutex_lock(&pool->lock);
+	while (!report->done) pthread_cond_wait(&pool->work_done, &pool->lock);
+	pthread_mutex_unlock(&pool->lock);
+	if (report->out.failed) printReportRows(stream, report);
+	else fwrite(report->out.buffer, 1, report->out.used, stream);
+	pthread_mutex_lock(&pool->lock);
+	pool->first = report->next;
+	if (pool->first == NULL) pool->last = NULL;
+	updateSafeEpoch(pool);
+	pthread_mutex_unlock(&pool->lock);
+	freeReport(report);
+}
+
+/**
+ * @brief Escreve, pela ordem da entrada, todos os relatórios pedidos, 
+ * esperando pelos que ainda estão a ser formatados, e libera os lotes e 
+ * registros retirados que já nenhum relatório pode ver. É chamada antes de 
+ * cada escrita da saída do sistema no fluxo, por flushSystemOutput.
+ * 
+ * @param pool O conjunto dos relatórios.
+ */
+void flushReports(ReportPool *pool) {
+	VaccinationSystem *vs = pool->vs;
+	while (pool->first != NULL) emitReport(pool, vs->output.stream);
+	reclaimRetired(&vs->batches_ht->retired);
+	if (vs->shards == NULL) reclaimRetired(&vs->records_ht->retired);
+}
+
+/**
+ * @brief Cria as threads dos relatórios no primeiro relatório pedido. Os 
+ * comandos das partições, que escrevem em memória, listam sempre logo.
+ * 
+ * @param vs O sistema de vacinação.
+ * 
+ * @return 1 se há threads dos relatórios, 0 caso contrário.
+ */
+int startReportPool(VaccinationSystem *vs) {
+	ReportPool *pool;
+	int count = reportThreadCount();
+	if (vs->reports != NULL) return 1;
+	if (vs->output.stream == NULL) return 0;
+	pool = calloc(1, sizeof(ReportPool));
+	if (pool == NULL) return 0;
+	pool->vs = vs;
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->work_ready, NULL);
+	pthread_cond_init(&pool->work_done, NULL);
+	for (; pool->running < count; pool->running++)
+		if (pthread_create(&pool->threads[pool->running], NULL, 
+			reportWorkerMain, pool) != 0) break;
+	vs->reports = pool;
+	if (pool->running == 0) {
+		destroyReportPool(vs);
+		return 0;
+	}
+	return 1;
+}
+
+/**
+ * @brief Entrega um relatório, com as linhas já fixadas, às threads dos 
+ * relatórios. A saída acumulada até aqui passa a anteceder o relatório e a 
+ * época atual fica fixada até a formatação terminar.
+ * 
+ * @param vs O sistema de vacinação.
+ * @param kind 'l' para lotes, 'u' para registros.
+ * @param rows As linhas, que passam a pertencer ao relatório.
+ * @param count O número de linhas.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória, caso em que as linhas 
+ * são liberadas.
+ */
+int submitReport(VaccinationSystem *vs, char kind, void *rows, 
+	size_t count) {
+	ReportPool *pool = vs->reports;
+	Report *report = calloc(1, sizeof(Report));
+	if (report == NULL || (vs->output.used > 0 && !detachOutput( 
+		&vs->output, &report->prefix, &report->prefix_length))) {
+		free(report);
+		free(rows);
+		return 0;
+	}
+	report->kind = kind;
+	report->rows = rows;
+	report->count = count;
+	pthread_mutex_lock(&pool->lock);
+	report->epoch = atomic_fetch_add(&vs->epochs.current, 1);
+	if (pool->last != NULL) pool->last->next = report;
+	else pool->first = report;
+	pool->last = report;
+	if (pool->next_job == NULL) pool->next_job = report;
+	updateSafeEpoch(pool);
+	pthread_cond_signal(&pool->work_ready);
+	pthread_mutex_unlock(&pool->lock);
+	return 1;
+}
+
+/**
+ * @brief Lista todos os lotes noutra thread, se forem pelo menos 
+ * REPORT_MIN_LINES.
+ * 
+ * @param vs O sistema de vacinação.
+ * 
+ * @return 1 se a listagem foi entregue a outra thread, 0 se tem de ser 
+ * impressa logo.
+ */
+int reportAllBatches(VaccinationSystem *vs) {
+	size_t count = vs->batches_ht->batches.count;
+	BatchView *views;
+	if (count < REPORT_MIN_LINES || !startReportPool(vs)) return 0;
+	views = malloc(sizeof(BatchView) * count);
+	if (views == NULL) return 0;
+	count = viewAllBatches(vs->batches_ht, views);
+	return submitReport(vs, 'l', views, count);
+}
+
+/**
+ * @brief Lista todos os registros de vacinação noutra thread, se forem 
+ * pelo menos REPORT_MIN_LINES.
+ * 
+ * @param vs O sistema de vacinação.
+ * 
+ * @return 1 se a listagem foi entregue a outra thread, 0 se tem de ser 
+ * impressa logo.
+ */
+int reportAllRecords(VaccinationSystem *vs) {
+	VaccinationRecord **records;
+	size_t count = countAllRecords(vs->record_shards, vs->shard_count);
+	if (count < REPORT_MIN_LINES || !startReportPool(vs)) return 0;
+	records = malloc(sizeof(VaccinationRecord*) * count);
+	if (records == NULL) return 0;
+	collectAllRecords(vs->record_shards, vs->shard_count, records);
+	return submitReport(vs, 'u', records, count);
+}
+
+/**
+ * @brief Lista os registros de vacinação de um usuário noutra thread, se 
+ * forem pelo menos REPORT_MIN_LINES.
+ * 
+ * @param vs O sistema de vacinação.
+ * @param records A partição dos registros do usuário.
+ * @param user_name O nome do usuário, que existe no sistema.
+ * 
+ * @return 1 se a listagem foi entregue a outra thread, 0 se tem de ser 
+ * impressa logo.
+ */
+int reportUserRecords(VaccinationSystem *vs, 
+	VaccinationRecordsHashtable *records, const char *user_name) {
+	VaccinationRecordsUser *user = findUser(records, user_name);
+	VaccinationRecord **rows;
+	size_t count = (size_t)user->record_count;
+	if (count < REPORT_MIN_LINES || !startReportPool(vs)) return 0;
+	rows = malloc(sizeof(VaccinationRecord*) * count);
+	if (rows == NULL) return 0;
+	memcpy(rows, user->records, sizeof(VaccinationRecord*) * count);
+	return submitReport(vs, 'u', rows, count);
+}
+
+/**
+ * @brief Escreve a saída pendente e os relatórios em curso, pelo mesmo 
+ * caminho das outras escritas no fluxo, para as threads dos relatórios e 
+ * libera os seus recursos.
+ * 
+ * @param vs O sistema de vacinação.
+ */
+void destroyReportPool(VaccinationSystem *vs) {
+	ReportPool *pool = vs->reports;
+	int i;
+	if (pool == NULL) return;
+	flushOutput(&vs->output);
+	pthread_mutex_lock(&pool->lock);
+	pool->stop = 1;
+	pthread_cond_broadcast(&pool->work_ready);
+	pthread_mutex_unlock(&pool->lock);
+	for (i = 0; i < pool->running; i++)
+		pthread_join(pool->threads[i], NULL);
+	pthread_mutex_destroy(&pool->lock);
+	pthread_cond_destroy(&pool->work_ready);
+	pthread_cond_destroy(&pool->work_done);
+	vs->reports = NULL;
+	free(pool);
+}
@@ -0,0 +1,67 @@
+/**
+ * @file report.h
+ * @author Diogo Lobo (ist1109293)
+ * @brief Cabeçalho dos relatórios concorrentes. As listagens longas (`l`, 
+ * `u` e `u nome`) fixam na thread principal o estado a listar e são 
+ * formatadas noutras threads, enquanto os comandos seguintes continuam; a 
+ * saída de cada relatório é escrita no seu lugar, pela ordem da entrada, e 
+ * os lotes e registros entretanto removidos só são liberados quando nenhum 
+ * relatório os puder ainda ver.
+ * @date 2026-10-16
+ */
+
+#ifndef REPORT_H
+#define REPORT_H
+
+#include <pthread.h>
+#include <stdio.h>
+#include "system.h"
+
+/** Número mínimo de linhas de uma listagem para ser feita noutra thread; 
+ * as mais curtas são impressas logo. */
+#define REPORT_MIN_LINES 4096
+
+/** Número máximo de threads dos relatórios. */
+#define REPORT_MAX_THREADS 8
+
+/** Estrutura que representa uma listagem a formatar noutra thread. */
+typedef struct Report {
+    char kind; /** 'l' para lotes (BatchView), 'u' para registros 
+    (VaccinationRecord*). */
+    void *rows; /** Linhas a listar, fixadas pela thread principal. */
+    size_t count; /** Número de linhas. */
+    char *prefix; /** Saída da thread principal anterior ao relatório. */
+    size_t prefix_length; /** Número de bytes de `prefix`. */
+    Output out; /** Saída do relatório, em memória. */
+    unsigned long long epoch; /** Época em que as linhas foram fixadas. */
+    int done; /** 1 quando a formatação terminou. */
+    struct Report *next; /** Relatório seguinte, pela ordem da entrada. */
+} Report;
+
+/** Estrutura que representa as threads dos relatórios e os relatórios 
+ * ainda por escrever. */
+typedef struct ReportPool {
+    pthread_t threads[REPORT_MAX_THREADS]; /** Threads dos relatórios. */
+    int running; /** Número de threads criadas. */
+    VaccinationSystem *vs; /** Sistema de vacinação. */
+    pthread_mutex_t lock; /** Protege a lista e o estado dos relatórios. */
+    pthread_cond_t work_ready; /** Sinaliza um relatório novo ou o fim. */
+    pthread_cond_t work_done; /** Sinaliza um relatório formatado. */
+    Report *first; /** Relatório mais antigo por escrever. */
+    Report *last; /** Relatório mais recente. */
+    Report *next_job; /** Primeiro relatório ainda por formatar. */
+    int stop; /** 1 quando as threads devem terminar. */
+} ReportPool;
+
+int reportAllBatches(VaccinationSystem *vs);
+
+int reportAllRecords(VaccinationSystem *vs);
+
+int reportUserRecords(VaccinationSystem *vs, 
+VaccinationRecordsHashtable *records, const char *user_name);
+
+void flushReports(ReportPool *pool);
+
+void destroyReportPool(VaccinationSystem *vs);
+
+#endif
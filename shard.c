@@ -0,0 +1,533 @@
+/**
+ * @file shard.c
+ * @author Diogo Lobo (ist1109293)
+ * @brief Implementação do modo com partições.
+ * @date 2026-10-16
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "constants.h"
+#include "utils.h"
+#include "shard.h"
+
+/**
+ * @brief Coloca um comando na fila de uma partição e acorda a sua thread, 
+ * se estiver à espera. Nunca enche, porque não há mais do que SHARD_WINDOW 
+ * comandos em curso.
+ * 
+ * @param worker A thread da partição.
+ * @param index A posição do comando na janela.
+ */
+void pushShardTask(ShardWorker *worker, int index) {
+	ShardQueue *queue = &worker->queue;
+	unsigned int tail = atomic_load_explicit(&queue->tail, 
+		memory_order_relaxed);
+	queue->items[tail % SHARD_WINDOW] = index;
+	atomic_store(&queue->tail, tail + 1);
+	if (atomic_load(&worker->sleeping)) {
+		pthread_mutex_lock(&worker->lock);
+		pthread_cond_signal(&worker->wake);
+		pthread_mutex_unlock(&worker->lock);
+	}
+}
+
+/**
+ * @brief Retira o comando seguinte da fila de uma partição.
+ * 
+ * @param queue A fila.
+ * @param index A posição do comando na janela.
+ * 
+ * @return 1 se havia um comando, 0 se a fila estava vazia.
+ */
+int popShardTask(ShardQueue *queue, int *index) {
+	unsigned int head = atomic_load_explicit(&queue->head, 
+		memory_order_relaxed);
+	if (head == atomic_load(&queue->tail)) return 0;
+	*index = queue->items[head % SHARD_WINDOW];
+	atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+	return 1;
+}
+
+/**
+ * @brief Espera, sem ocupar o processador, por um comando novo na fila de 
+ * uma partição ou pelo fim do conjunto.
+ * 
+ * @param worker A thread da partição.
+ */
+void parkShardWorker(ShardWorker *worker) {
+	ShardQueue *queue = &worker->queue;
+	pthread_mutex_lock(&worker->lock);
+	atomic_store(&worker->sleeping, 1);
+	while (atomic_load(&queue->head) == atomic_load(&queue->tail) && 
+		!atomic_load(&worker->pool->stop))
+		pthread_cond_wait(&worker->wake, &worker->lock);
+	atomic_store(&worker->sleeping, 0);
+	pthread_mutex_unlock(&worker->lock);
+}
+
+/**
+ * @brief Espera pela vez de um comando `a` na sua vacina. Se a vez ainda 
+ * não chegou, a thread dorme até um comando da mesma vacina terminar, em 
+ * vez de ocupar o processador de que esse comando precisa.
+ * 
+ * @param pool O conjunto das partições.
+ * @param slot O comando `a`, com vacina.
+ */
+void waitVaccineTurn(ShardPool *pool, ShardSlot *slot) {
+	atomic_uint *turn = &pool->turns[slot->vaccine->id];
+	if (atomic_load_explicit(turn, memory_order_acquire) == slot->ticket)
+		return;
+	pthread_mutex_lock(&pool->turn_lock);
+	atomic_fetch_add(&pool->turn_waiters, 1);
+	while (atomic_load(turn) != slot->ticket)
+		pthread_cond_wait(&pool->turn_changed, &pool->turn_lock);
+	atomic_fetch_sub(&pool->turn_waiters, 1);
+	pthread_mutex_unlock(&pool->turn_lock);
+}
+
+/**
+ * @brief Passa a vez de uma vacina ao comando `a` seguinte, acordando as 
+ * threads que esperam por uma vez.
+ * 
+ * @param pool O conjunto das partições.
+ * @param slot O comando `a` que terminou, com vacina.
+ */
+void passVaccineTurn(ShardPool *pool, ShardSlot *slot) {
+	atomic_fetch_add(&pool->turns[slot->vaccine->id], 1);
+	if (atomic_load(&pool->turn_waiters) == 0) return;
+	pthread_mutex_lock(&pool->turn_lock);
+	pthread_cond_broadcast(&pool->turn_changed);
+	pthread_mutex_unlock(&pool->turn_lock);
+}
+
+/**
+ * @brief Aplica uma dose numa partição. Os comandos `a` da mesma vacina 
+ * correm pela ordem da entrada, cada um na sua vez, porque escolhem e gastam 
+ * lotes da mesma vacina; os de vacinas diferentes correm em paralelo.
+ * 
+ * @param pool O conjunto das partições.
+ * @param slot O comando `a`.
+ */
+void applyShardVaccine(ShardPool *pool, ShardSlot *slot) {
+	VaccinationSystem *view = &slot->view;
+	BatchInfo *batch = NULL;
+	int result;
+	if (slot->vaccine != NULL) {
+		waitVaccineTurn(pool, slot);
+		batch = oldestValidBatchOfVaccine(slot->vaccine);
+	}
+	if (batch == NULL)
+		printError(&view->output, ENOSTOCK, ENOSTOCKPT, pool->pt);
+	else {
+		view->records_ht->next_seq = slot->seq;
+		result = insertVaccinationRecord(view->records_ht, 
+			slot->tokens[1].text, batch, view->current_date);
+		if (result == 0) slot->result = SHARD_NO_MEMORY;
+		else if (result == 2) printError(&view->output, 
+			EALREADYVACCINATED, EALREADYVACCINATEDPT, pool->pt);
+		else {
+			applyDoseFromBatch(view->batches_ht, batch);
+			outputString(&view->output, batch->batch);
+			outputChar(&view->output, '\n');
+			slot->batch = batch;
+			slot->result = 1;
+		}
+	}
+	if (slot->vaccine != NULL) passVaccineTurn(pool, slot);
+}
+
+/**
+ * @brief Executa um comando na thread da sua partição e avisa a thread 
+ * principal, se estiver à espera.
+ * 
+ * @param pool O conjunto das partições.
+ * @param slot O comando.
+ */
+void runShardSlot(ShardPool *pool, ShardSlot *slot) {
+	if (slot->kind == 'a') applyShardVaccine(pool, slot);
+	else if (slot->kind == 'd') {
+		slot->result = deleteRecordInput(&slot->view, slot->tokens, 
+			slot->count, pool->pt);
+		if (slot->result == RECORD_NO_MEMORY) 
+			slot->result = SHARD_NO_MEMORY;
+	}
+	else listRecordsInput(&slot->view, slot->tokens, slot->count, 
+		pool->pt);
+	atomic_store(&slot->done, 1);
+	if (atomic_load(&pool->waiting)) {
+		pthread_mutex_lock(&pool->lock);
+		pthread_cond_signal(&pool->slot_done);
+		pthread_mutex_unlock(&pool->lock);
+	}
+}
+
+/**
+ * @brief Ciclo da thread de uma partição: executa os comandos da sua fila 
+ * pela ordem de chegada, até o conjunto ser parado e a fila ficar vazia.
+ * 
+ * @param arg A thread da partição (ShardWorker).
+ * 
+ * @return NULL.
+ */
+void* shardWorkerMain(void *arg) {
+	ShardWorker *worker = (ShardWorker*)arg;
+	ShardPool *pool = worker->pool;
+	int index;
+	while (1) {
+		if (popShardTask(&worker->queue, &index))
+			runShardSlot(pool, &pool->slots[index]);
+		else if (atomic_load(&pool->stop)) break;
+		else parkShardWorker(worker);
+	}
+	return NULL;
+}
+
+/**
+ * @brief Espera que a partição de um comando o termine.
+ * 
+ * @param pool O conjunto das partições.
+ * @param slot O comando.
+ */
+void waitShardSlot(ShardPool *pool, ShardSlot *slot) {
+	if (atomic_load_explicit(&slot->done, memory_order_acquire)) return;
+	pthread_mutex_lock(&pool->lock);
+	atomic_store(&pool->waiting, 1);
+	while (!atomic_load(&slot->done))
+		pthread_cond_wait(&pool->slot_done, &pool->lock);
+	atomic_store(&pool->waiting, 0);
+	pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief Acrescenta ao diário as mutações do comando mais antigo, já 
+ * terminado, e escreve a sua saída. Se o comando ficou sem memória, o 
+ * programa é finalizado.
+ * 
+ * @param pool O conjunto das partições.
+ */
+void emitShardSlot(ShardPool *pool) {
+	VaccinationSystem *vs = pool->vs;
+	ShardSlot *slot = &pool->slots[pool->first % SHARD_WINDOW];
+	pool->first++;
+	pool->emitting = 1;
+	if (slot->result == SHARD_NO_MEMORY || slot->view.output.failed)
+		endProgramMemError(vs, pool->pt);
+	if (slot->kind == 'a' && slot->result == 1)
+		checkJournal(vs, journalApplyDose(&vs->journal, 
+			slot->tokens[1].text, slot->batch->batch), pool->pt);
+	else if (slot->kind == 'd' && slot->result > 0)
+		journalDeleteInput(vs, slot->tokens, slot->count, pool->pt);
+	outputBytes(&vs->output, slot->view.output.buffer, 
+		slot->view.output.used);
+	pool->emitting = 0;
+}
+
+/**
+ * @brief Escreve, pela ordem da entrada, a saída dos comandos já 
+ * terminados, até o primeiro que ainda esteja em curso.
+ * 
+ * @param pool O conjunto das partições.
+ */
+void emitReadyShardSlots(ShardPool *pool) {
+	while (pool->first != pool->next && atomic_load_explicit( 
+		&pool->slots[pool->first % SHARD_WINDOW].done, 
+		memory_order_acquire))
+		emitShardSlot(pool);
+}
+
+/**
+ * @brief Espera por todos os comandos em curso e escreve a sua saída. 
+ * Depois disto, a thread principal é a única a usar o sistema até ao 
+ * comando seguinte entregue a uma partição.
+ * 
+ * @param vs O sistema de vacinação.
+ */
+void drainShards(VaccinationSystem *vs) {
+	ShardPool *pool = vs->shards;
+	if (pool == NULL) return;
+	while (pool->first != pool->next) {
+		waitShardSlot(pool, &pool->slots[pool->first % SHARD_WINDOW]);
+		emitShardSlot(pool);
+	}
+}
+
+/**
+ * @brief Garante que uma vacina já tem vez. Os vetores das vezes só 
+ * crescem depois de todos os comandos em curso terminarem.
+ * 
+ * @param vs O sistema de vacinação.
+ * @param id O ID da vacina.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+int reserveShardTickets(VaccinationSystem *vs, int id) {
+	ShardPool *pool = vs->shards;
+	unsigned int *tickets;
+	atomic_uint *turns;
+	int i, capacity = pool->ticket_capacity;
+	if (id < capacity) return 1;
+	drainShards(vs);
+	while (capacity <= id) capacity = capacity * 2 + 8;
+	tickets = realloc(pool->tickets, sizeof(unsigned int) * capacity);
+	if (tickets == NULL) return 0;
+	pool->tickets = tickets;
+	turns = realloc(pool->turns, sizeof(atomic_uint) * capacity);
+	if (turns == NULL) return 0;
+	pool->turns = turns;
+	for (i = pool->ticket_capacity; i < capacity; i++) {
+		tickets[i] = 0;
+		atomic_init(&turns[i], 0);
+	}
+	pool->ticket_capacity = capacity;
+	return 1;
+}
+
+/**
+ * @brief Copia os argumentos de um comando para a arena do seu lugar na 
+ * janela, porque a linha original pode ser reutilizada antes de o comando 
+ * terminar.
+ * 
+ * @param slot O lugar do comando.
+ * @param command O comando.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+int copyShardTokens(ShardSlot *slot, Command *command) {
+	Token *tokens = command->tokens;
+	int i;
+	slot->tokens = arenaAlloc(&slot->view.scratch, 
+		sizeof(Token) * command->count);
+	if (slot->tokens == NULL) return 0;
+	for (i = 0; i < command->count; i++) {
+		slot->tokens[i].length = tokens[i].length;
+		slot->tokens[i].text = arenaAlloc(&slot->view.scratch, 
+			tokens[i].length + 1);
+		if (slot->tokens[i].text == NULL) return 0;
+		memcpy(slot->tokens[i].text, tokens[i].text, 
+			tokens[i].length + 1);
+	}
+	slot->count = command->count;
+	return 1;
+}
+
+/**
+ * @brief Prepara o lugar de um comando na janela: copia os argumentos, 
+ * escolhe a partição do usuário e, no comando `a`, a vez na vacina e o 
+ * número de sequência do registro.
+ * 
+ * @param vs O sistema de vacinação.
+ * @param slot O lugar do comando.
+ * @param command O comando.
+ * @param vaccine A vacina do comando `a`, ou NULL.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+int prepareShardSlot(VaccinationSystem *vs, ShardSlot *slot, 
+	Command *command, Vaccine *vaccine) {
+	ShardPool *pool = vs->shards;
+	VaccinationSystem *view = &slot->view;
+	resetArena(&view->scratch);
+	view->output.used = 0;
+	if (!copyShardTokens(slot, command)) return 0;
+	slot->kind = command->input[0];
+	slot->shard = (int)(hashString(slot->tokens[1].text, SHARD_HASH_SEED) %
+		(unsigned)vs->shard_count);
+	view->records_ht = vs->record_shards[slot->shard];
+	view->current_date = vs->current_date;
+	slot->vaccine = vaccine;
+	slot->batch = NULL;
+	slot->result = -1;
+	if (slot->kind == 'a') slot->seq = vs->next_seq++;
+	if (vaccine != NULL) slot->ticket = pool->tickets[vaccine->id]++;
+	atomic_store_explicit(&slot->done, 0, memory_order_relaxed);
+	return 1;
+}
+
+/**
+ * @brief Entrega um comando `a`, `d` ou `u nome` à partição do usuário, 
+ * esperando antes pelo comando mais antigo se a janela estiver cheia.
+ * 
+ * @param vs O sistema de vacinação.
+ * @param command O comando.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+int submitShardCommand(VaccinationSystem *vs, Command *command) {
+	ShardPool *pool = vs->shards;
+	Vaccine *vaccine = NULL;
+	ShardSlot *slot;
+	unsigned long index;
+	if (command->input[0] == 'a')
+		vaccine = searchVaccine(vs->batches_ht->vaccines, 
+			tokenText(command->tokens, command->count, 2));
+	if (vaccine != NULL && !reserveShardTickets(vs, vaccine->id))
+		return 0;
+	if (pool->next - pool->first == SHARD_WINDOW) {
+		waitShardSlot(pool, &pool->slots[pool->first % SHARD_WINDOW]);
+		emitShardSlot(pool);
+	}
+	index = pool->next % SHARD_WINDOW;
+	slot = &pool->slots[index];
+	if (!prepareShardSlot(vs, slot, command, vaccine)) return 0;
+	pool->next++;
+	pushShardTask(&pool->workers[slot->shard], (int)index);
+	return 1;
+}
+
+/**
+ * @brief Entrega um comando à partição do usuário, se for um comando `a`, 
+ * `d` ou `u` com o nome de um usuário, e escreve a saída dos comandos que 
+ * já terminaram. Qualquer outro comando espera por todos os comandos em 
+ * curso, para depois correr sozinho na thread principal.
+ * 
+ * @param vs O sistema de vacinação, com as partições ativas.
+ * @param command O comando.
+ * @param pt Indicador de idioma (1 para português, 0 para outro idioma).
+ * 
+ * @return 1 se o comando foi entregue a uma partição, 0 se tem de correr 
+ * na thread principal.
+ */
+int dispatchShardCommand(VaccinationSystem *vs, Command *command, int pt) {
+	char kind = command->input[0];
+	if ((kind != 'a' && kind != 'd' && kind != 'u') || command->count < 2) {
+		drainShards(vs);
+		return 0;
+	}
+	if (!submitShardCommand(vs, command)) {
+		drainShards(vs);
+		endProgramMemError(vs, pt);
+	}
+	emitReadyShardSlots(vs->shards);
+	return 1;
+}
+
+/**
+ * @brief Prepara os lugares da janela. Cada um vê os lotes e a data do 
+ * sistema, mas tem a sua arena, a sua saída em memória e o diário 
+ * desativado; o diário é escrito pela thread principal.
+ * 
+ * @param vs O sistema de vacinação.
+ * @param pool O conjunto das partições.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+int initShardSlots(VaccinationSystem *vs, ShardPool *pool) {
+	VaccinationSystem *view;
+	int i;
+	pool->slots = calloc(SHARD_WINDOW, sizeof(ShardSlot));
+	if (pool->slots == NULL) return 0;
+	for (i = 0; i < SHARD_WINDOW; i++) {
+		view = &pool->slots[i].view;
+		view->batches_ht = vs->batches_ht;
+		view->record_shards = &view->records_ht;
+		view->shard_count = 1;
+		view->shards = NULL;
+		view->reports = NULL;
+		initJournal(&view->journal);
+		if (!initArena(&view->scratch, SHARD_SLOT_SIZE) || 
+			!initMemoryOutput(&view->output, SHARD_SLOT_SIZE))
+			return 0;
+	}
+	return 1;
+}
+
+/**
+ * @brief Cria as threads das partições, uma por partição dos registros.
+ * 
+ * @param pool O conjunto das partições.
+ * @param count O número de partições.
+ * 
+ * @return 1 em caso de sucesso, 0 se não for possível criar uma thread.
+ */
+int startShardWorkers(ShardPool *pool, int count) {
+	ShardWorker *worker;
+	pool->workers = calloc(count, sizeof(ShardWorker));
+	if (pool->workers == NULL) return 0;
+	for (; pool->running < count; pool->running++) {
+		worker = &pool->workers[pool->running];
+		worker->pool = pool;
+		pthread_mutex_init(&worker->lock, NULL);
+		pthread_cond_init(&worker->wake, NULL);
+		if (pthread_create(&worker->thread, NULL, shardWorkerMain, 
+			worker) != 0) {
+			pthread_mutex_destroy(&worker->lock);
+			pthread_cond_destroy(&worker->wake);
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/**
+ * @brief Ativa o modo com partições, depois de o estado inicial do sistema 
+ * ter sido carregado.
+ * 
+ * @param vs O sistema de vacinação, com mais do que uma partição.
+ * @param pt Indicador de idioma (1 para português, 0 para outro idioma).
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória ou não for possível 
+ * criar as threads.
+ */
+int startShardPool(VaccinationSystem *vs, int pt) {
+	ShardPool *pool = calloc(1, sizeof(ShardPool));
+	if (pool == NULL) return 0;
+	vs->shards = pool;
+	pool->vs = vs;
+	pool->pt = pt;
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->slot_done, NULL);
+	pthread_mutex_init(&pool->turn_lock, NULL);
+	pthread_cond_init(&pool->turn_changed, NULL);
+	return initShardSlots(vs, pool) && 
+		startShardWorkers(pool, vs->shard_count);
+}
+
+/**
+ * @brief Para as threads das partições, que terminam antes os comandos das 
+ * suas filas, e libera os recursos do conjunto.
+ * 
+ * @param pool O conjunto das partições.
+ */
+void freeShardPool(ShardPool *pool) {
+	int i;
+	atomic_store(&pool->stop, 1);
+	for (i = 0; i < pool->running; i++) {
+		pthread_mutex_lock(&pool->workers[i].lock);
+		pthread_cond_signal(&pool->workers[i].wake);
+		pthread_mutex_unlock(&pool->workers[i].lock);
+	}
+	for (i = 0; i < pool->running; i++) {
+		pthread_join(pool->workers[i].thread, NULL);
+		pthread_mutex_destroy(&pool->workers[i].lock);
+		pthread_cond_destroy(&pool->workers[i].wake);
+	}
+	for (i = 0; pool->slots && i < SHARD_WINDOW; i++) {
+		destroyArena(&pool->slots[i].view.scratch);
+		free(pool->slots[i].view.output.buffer);
+	}
+	pthread_mutex_destroy(&pool->lock);
+	pthread_cond_destroy(&pool->slot_done);
+	pthread_mutex_destroy(&pool->turn_lock);
+	pthread_cond_destroy(&pool->turn_changed);
+	free(pool->slots);
+	free(pool->workers);
+	free(pool->tickets);
+	free(pool->turns);
+	free(pool);
+}
+
+/**
+ * @brief Termina o modo com partições: escreve a saída dos comandos em 
+ * curso, exceto se o programa estiver a ser finalizado durante a escrita 
+ * de um deles, e para as threads.
+ * 
+ * @param vs O sistema de vacinação.
+ */
+void destroyShardPool(VaccinationSystem *vs) {
+	ShardPool *pool = vs->shards;
+	if (pool == NULL) return;
+	if (!pool->emitting) drainShards(vs);
+	vs->shards = NULL;
+	freeShardPool(pool);
+}
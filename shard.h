@@ -0,0 +1,104 @@
+/**
+ * @file shard.h
+ * @author Diogo Lobo (ist1109293)
+ * @brief Cabeçalho do modo com partições. Os registros de vacinação são 
+ * divididos pelo hash do nome do usuário e cada partição pertence a uma 
+ * thread; a thread principal entrega os comandos `a`, `d` e `u nome` à 
+ * thread da partição do usuário por filas sem locks e escreve a saída de 
+ * cada comando pela ordem da entrada. Os restantes comandos esperam que 
+ * terminem todos os comandos em curso e correm na thread principal.
+ * @date 2026-10-16
+ */
+
+#ifndef SHARD_H
+#define SHARD_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include "arena.h"
+#include "commands.h"
+#include "system.h"
+
+/** Número máximo de comandos entregues às partições e ainda não escritos; 
+ * também é a capacidade da fila de cada partição. */
+#define SHARD_WINDOW 1024
+
+/** Capacidade inicial da arena e da saída de cada comando em curso. */
+#define SHARD_SLOT_SIZE 256
+
+/** Resultado de um comando em curso que ficou sem memória. */
+#define SHARD_NO_MEMORY -2
+
+struct ShardPool;
+
+/** Estrutura que representa um comando entregue a uma partição. */
+typedef struct ShardSlot {
+    VaccinationSystem view; /** Sistema visto pelo comando: os lotes 
+    partilhados, os registros da partição e uma saída em memória; a arena 
+    guarda a cópia dos argumentos. */
+    char kind; /** Letra do comando. */
+    Token *tokens; /** Cópia dos argumentos do comando. */
+    int count; /** Número de argumentos. */
+    int shard; /** Partição do usuário do comando. */
+    Vaccine *vaccine; /** Vacina do comando `a`, ou NULL se não existir. */
+    unsigned int ticket; /** Vez do comando `a` entre os da mesma vacina. */
+    unsigned long long seq; /** Número de sequência do registro do comando 
+    `a`. */
+    BatchInfo *batch; /** Lote usado pelo comando `a`, se tiver sucesso. */
+    int result; /** Doses aplicadas ou registros apagados, -1 em caso de 
+    erro ou SHARD_NO_MEMORY. */
+    atomic_int done; /** 1 quando a partição terminou o comando. */
+} ShardSlot;
+
+/** Fila sem locks de um só produtor (a thread principal) e um só 
+ * consumidor (a thread da partição), com as posições dos comandos. */
+typedef struct ShardQueue {
+    int items[SHARD_WINDOW]; /** Posições dos comandos na janela. */
+    atomic_uint head; /** Número de comandos já retirados. */
+    atomic_uint tail; /** Número de comandos já colocados. */
+} ShardQueue;
+
+/** Estrutura que representa a thread de uma partição. */
+typedef struct ShardWorker {
+    pthread_t thread; /** Thread do sistema. */
+    struct ShardPool *pool; /** Conjunto a que a thread pertence. */
+    ShardQueue queue; /** Comandos por executar. */
+    pthread_mutex_t lock; /** Protege a espera da thread com a fila 
+    vazia. */
+    pthread_cond_t wake; /** Sinaliza um comando novo ou o fim. */
+    atomic_int sleeping; /** 1 enquanto a thread espera por comandos. */
+} ShardWorker;
+
+/** Estrutura que representa o conjunto das threads das partições. */
+typedef struct ShardPool {
+    VaccinationSystem *vs; /** Sistema de vacinação. */
+    int pt; /** Indicador de idioma das mensagens de erro. */
+    ShardWorker *workers; /** Uma thread por partição. */
+    int running; /** Número de threads criadas. */
+    ShardSlot *slots; /** Janela circular dos comandos em curso. */
+    unsigned long first; /** Número do comando mais antigo por escrever. */
+    unsigned long next; /** Número do comando seguinte. */
+    unsigned int *tickets; /** Próxima vez a dar em cada vacina. */
+    atomic_uint *turns; /** Vez atual em cada vacina. */
+    pthread_mutex_t turn_lock; /** Protege a espera pela vez de uma 
+    vacina. */
+    pthread_cond_t turn_changed; /** Sinaliza que a vez de uma vacina 
+    avançou. */
+    atomic_int turn_waiters; /** Número de threads à espera de uma vez. */
+    int ticket_capacity; /** Número de vacinas com vez. */
+    int emitting; /** 1 enquanto se escreve a saída de um comando. */
+    atomic_int stop; /** 1 quando as threads devem terminar. */
+    pthread_mutex_t lock; /** Protege a espera da thread principal. */
+    pthread_cond_t slot_done; /** Sinaliza um comando terminado. */
+    atomic_int waiting; /** 1 enquanto a thread principal espera. */
+} ShardPool;
+
+int startShardPool(VaccinationSystem *vs, int pt);
+
+int dispatchShardCommand(VaccinationSystem *vs, Command *command, int pt);
+
+void drainShards(VaccinationSystem *vs);
+
+void destroyShardPool(VaccinationSystem *vs);
+
+#endif
@@ -0,0 +1,643 @@
+/**
+ * @file snapshot.c
+ * @author Diogo Lobo (ist1109293)
+ * @brief Implementação do snapshot binário do sistema de vacinação. O 
+ * arquivo é escrito num temporário e só substitui o anterior depois de 
+ * completo; na leitura é mapeado em memória, verificado e carregado em 
+ * bloco, sem interpretar texto.
+ * @date 2026-10-16
+ */
+/** Expõe pwrite, que é POSIX, mesmo quando se compila em C99 estrito. */
+#define _POSIX_C_SOURCE 200809L
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "snapshot.h"
+#include "utils.h"
+
+/**
+ * @brief Acumula as palavras completas de 8 bytes de um bloco no código de 
+ * verificação.
+ * 
+ * @param state O código de verificação dos blocos anteriores.
+ * @param data O bloco.
+ * @param size O tamanho do bloco; os bytes que não completam uma palavra 
+ * são ignorados.
+ * 
+ * @return O novo código de verificação.
+ */
+uint64_t checksumWords(uint64_t state, const unsigned char *data, 
+	size_t size) {
+	uint64_t word;
+	size_t i;
+	for (i = 0; i + 8 <= size; i += 8) {
+		memcpy(&word, data + i, 8);
+		state = hashMix(state ^ word, SNAPSHOT_CHECKSUM_KEY);
+	}
+	return state;
+}
+
+/**
+ * @brief Conclui o código de verificação com os últimos bytes, que não 
+ * completam uma palavra, e com o tamanho total.
+ * 
+ * @param state O código de verificação das palavras completas.
+ * @param tail Os últimos bytes.
+ * @param tail_size O número de últimos bytes, menor que 8.
+ * @param length O tamanho total dos dados verificados.
+ * 
+ * @return O código de verificação final.
+ */
+uint64_t checksumFinish(uint64_t state, const unsigned char *tail, 
+	size_t tail_size, uint64_t length) {
+	uint64_t word = 0;
+	memcpy(&word, tail, tail_size);
+	return hashMix(state ^ word, length ^ SNAPSHOT_CHECKSUM_KEY);
+}
+
+/**
+ * @brief Devolve a chave de uma string da tabela de strings.
+ * 
+ * @param entry A string da tabela (SnapshotString).
+ * 
+ * @return O texto da string.
+ */
+const char* snapshotStringKey(const void *entry) {
+	return ((const SnapshotString*)entry)->text;
+}
+
+/**
+ * @brief Escreve todos os bytes no arquivo, repetindo as escritas parciais 
+ * e as interrompidas por um sinal.
+ * 
+ * @param fd O descritor do arquivo.
+ * @param data Os bytes a escrever.
+ * @param size O número de bytes.
+ * 
+ * @return 1 em caso de sucesso, 0 se a escrita falhar.
+ */
+int writeAll(int fd, const unsigned char *data, size_t size) {
+	ssize_t written;
+	while (size > 0) {
+		written = write(fd, data, size);
+		if (written < 0 && errno == EINTR) continue;
+		if (written <= 0) return 0;
+		data += written;
+		size -= (size_t)written;
+	}
+	return 1;
+}
+
+/**
+ * @brief Escreve o buffer no arquivo e acumula-o no código de verificação. 
+ * Só o último buffer pode ter um tamanho que não seja múltiplo de 8.
+ * 
+ * @param writer O snapshot em escrita.
+ */
+void flushSnapshot(SnapshotWriter *writer) {
+	writer->checksum = checksumWords(writer->checksum, writer->buffer, 
+		writer->used);
+	if (!writer->failed && 
+		!writeAll(writer->fd, writer->buffer, writer->used))
+		writer->failed = 1;
+	writer->written += writer->used;
+	writer->used = 0;
+}
+
+/**
+ * @brief Acrescenta bytes ao snapshot, esvaziando o buffer quando fica 
+ * cheio.
+ * 
+ * @param writer O snapshot em escrita.
+ * @param data Os bytes a acrescentar.
+ * @param size O número de bytes.
+ */
+void writeSnapshotBytes(SnapshotWriter *writer, const void *data, 
+	size_t size) {
+	const unsigned char *bytes = (const unsigned char*)data;
+	size_t chunk;
+	while (size > 0) {
+		chunk = SNAPSHOT_BUFFER_SIZE - writer->used;
+		if (chunk > size) chunk = size;
+		memcpy(writer->buffer + writer->used, bytes, chunk);
+		writer->used += chunk;
+		bytes += chunk;
+		size -= chunk;
+		if (writer->used == SNAPSHOT_BUFFER_SIZE) flushSnapshot(writer);
+	}
+}
+
+/**
+ * @brief Coloca uma string na tabela de strings, se ainda lá não estiver.
+ * 
+ * @param writer O snapshot em escrita.
+ * @param text O texto da string.
+ * 
+ * @return 1 em caso de sucesso, 0 se a tabela de strings exceder o limite 
+ * das posições de 32 bits e -1 se faltar memória.
+ */
+int internSnapshotString(SnapshotWriter *writer, const char *text) {
+	SnapshotString *string;
+	if (hashTableFind(&writer->strings, text) != NULL) return 1;
+	if (writer->strings_size > UINT32_MAX) return 0;
+	string = (SnapshotString*)arenaAlloc(&writer->arena, 
+		sizeof(SnapshotString));
+	if (string == NULL) return -1;
+	string->text = text;
+	string->offset = (uint32_t)writer->strings_size;
+	string->next = NULL;
+	if (!hashTableInsert(&writer->strings, string)) return -1;
+	if (writer->last != NULL) writer->last->next = string;
+	else writer->first = string;
+	writer->last = string;
+	writer->strings_size += strlen(text) + 1;
+	return 1;
+}
+
+/**
+ * @brief Devolve a posição de uma string já colocada na tabela de strings.
+ * 
+ * @param writer O snapshot em escrita.
+ * @param text O texto da string.
+ * 
+ * @return A posição da string na tabela.
+ */
+uint32_t snapshotStringOffset(SnapshotWriter *writer, const char *text) {
+	return ((SnapshotString*)hashTableFind(&writer->strings, text))->offset;
+}
+
+/**
+ * @brief Coloca na tabela de strings todos os nomes e IDs referidos pelos 
+ * registros, lotes e vacinas do sistema.
+ * 
+ * @param writer O snapshot em escrita.
+ * @param vs O sistema de vacinação.
+ * 
+ * @return 1 em caso de sucesso, 0 se a tabela de strings for demasiado 
+ * grande e -1 se faltar memória.
+ */
+int collectSnapshotStrings(SnapshotWriter *writer, VaccinationSystem *vs) {
+	VaccinesHashTable *vaccines = vs->batches_ht->vaccines;
+	BatchIndex *index = &vs->batches_ht->batch_index;
+	VaccinationRecord *record;
+	BatchInfo *batch;
+	RecordCursor cursor;
+	int i, result = 1;
+	initRecordCursor(&cursor, vs->record_shards, vs->shard_count);
+	while (result == 1 && (record = nextRecord(&cursor)) != NULL)
+		result = internSnapshotString(writer, record->user->user);
+	for (batch = firstInBatchIndex(index); result == 1 && batch;
+		batch = nextInBatchIndex(index, batch))
+		result = internSnapshotString(writer, batch->batch);
+	for (i = 0; result == 1 && i < vaccines->vaccine_count; i++)
+		result = internSnapshotString(writer, 
+			vaccineById(vaccines, i)->name);
+	return result;
+}
+
+/**
+ * @brief Escreve os registros de vacinação de todas as partições, pela 
+ * ordem cronológica.
+ * 
+ * @param writer O snapshot em escrita.
+ * @param vs O sistema de vacinação.
+ * 
+ * @return O número de registros escritos.
+ */
+uint64_t writeSnapshotRecords(SnapshotWriter *writer, 
+	VaccinationSystem *vs) {
+	SnapshotRecord entry;
+	VaccinationRecord *record;
+	RecordCursor cursor;
+	uint64_t count = 0;
+	initRecordCursor(&cursor, vs->record_shards, vs->shard_count);
+	while ((record = nextRecord(&cursor)) != NULL) {
+		entry.seq = record->seq;
+		entry.user = snapshotStringOffset(writer, record->user->user);
+		entry.batch = snapshotStringOffset(writer, 
+			record->batch->batch);
+		entry.vaccine_id = (uint32_t)record->vaccine_id;
+		entry.date = record->vaccination_date;
+		writeSnapshotBytes(writer, &entry, sizeof(entry));
+		count++;
+	}
+	return count;
+}
+
+/**
+ * @brief Escreve os lotes, pela ordem de data e ID.
+ * 
+ * @param writer O snapshot em escrita.
+ * @param batchHashTable A tabela de hash dos lotes.
+ * 
+ * @return O número de lotes escritos.
+ */
+uint64_t writeSnapshotBatches(SnapshotWriter *writer, 
+	BatchesHashTable *batchHashTable) {
+	BatchIndex *index = &batchHashTable->batch_index;
+	SnapshotBatch entry;
+	BatchInfo *batch;
+	uint64_t count = 0;
+	for (batch = firstInBatchIndex(index); batch;
+		batch = nextInBatchIndex(index, batch)) {
+		entry.batch = snapshotStringOffset(writer, batch->batch);
+		entry.vaccine_id = (uint32_t)batch->vaccine_id;
+		entry.date = batch->date;
+		entry.doses = batch->doses;
+		entry.applications = batch->applications;
+		writeSnapshotBytes(writer, &entry, sizeof(entry));
+		count++;
+	}
+	return count;
+}
+
+/**
+ * @brief Escreve os nomes das vacinas, pela ordem dos IDs, e a tabela de 
+ * strings.
+ * 
+ * @param writer O snapshot em escrita.
+ * @param vaccines O catálogo de vacinas.
+ */
+void writeSnapshotStrings(SnapshotWriter *writer, 
+	VaccinesHashTable *vaccines) {
+	SnapshotString *string;
+	uint32_t offset;
+	int i;
+	for (i = 0; i < vaccines->vaccine_count; i++) {
+		offset = snapshotStringOffset(writer, 
+			vaccineById(vaccines, i)->name);
+		writeSnapshotBytes(writer, &offset, sizeof(offset));
+	}
+	for (string = writer->first; string; string = string->next)
+		writeSnapshotBytes(writer, string->text, 
+			strlen(string->text) + 1);
+}
+
+/**
+ * @brief Escreve o corpo do snapshot e, no início do arquivo, o cabeçalho 
+ * com as contagens e o código de verificação.
+ * 
+ * @param writer O snapshot em escrita, com a tabela de strings completa.
+ * @param vs O sistema de vacinação.
+ * 
+ * @return 1 em caso de sucesso, 0 se a escrita falhar.
+ */
+int writeSnapshot(SnapshotWriter *writer, VaccinationSystem *vs) {
+	SnapshotHeader header;
+	size_t tail, used;
+	memset(&header, 0, sizeof(header));
+	if (lseek(writer->fd, sizeof(header), SEEK_SET) < 0) return 0;
+	header.record_count = writeSnapshotRecords(writer, vs);
+	header.batch_count = writeSnapshotBatches(writer, vs->batches_ht);
+	writeSnapshotStrings(writer, vs->batches_ht->vaccines);
+	used = writer->used;
+	tail = used & 7;
+	flushSnapshot(writer);
+	memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+	header.version = SNAPSHOT_VERSION;
+	header.byte_order = SNAPSHOT_BYTE_ORDER;
+	header.vaccine_count = 
+		(uint32_t)vs->batches_ht->vaccines->vaccine_count;
+	header.current_date = vs->current_date;
+	header.strings_size = writer->strings_size;
+	header.next_seq = vs->next_seq;
+	header.journal_lsn = vs->journal.next_lsn;
+	header.checksum = checksumFinish(writer->checksum, 
+		writer->buffer + used - tail, tail, writer->written);
+	return !writer->failed && pwrite(writer->fd, &header, sizeof(header), 
+		0) == (ssize_t)sizeof(header) && fsync(writer->fd) == 0;
+}
+
+/**
+ * @brief Prepara um snapshot em escrita para o arquivo dado.
+ * 
+ * @param writer O snapshot em escrita.
+ * @param fd O descritor do arquivo temporário.
+ * 
+ * @return 1 em caso de sucesso, 0 se faltar memória.
+ */
+int initSnapshotWriter(SnapshotWriter *writer, int fd) {
+	writer->fd = fd;
+	writer->used = 0;
+	writer->written = 0;
+	writer->checksum = SNAPSHOT_CHECKSUM_KEY;
+	writer->failed = 0;
+	writer->first = writer->last = NULL;
+	writer->strings_size = 0;
+	writer->buffer = (unsigned char*)malloc(SNAPSHOT_BUFFER_SIZE);
+	if (writer->buffer == NULL) return 0;
+	if (!initArena(&writer->arena, SNAPSHOT_ARENA_SIZE)) {
+		free(writer->buffer);
+		return 0;
+	}
+	if (!initHashTable(&writer->strings, snapshotStringKey)) {
+		destroyArena(&writer->arena);
+		free(writer->buffer);
+		return 0;
+	}
+	return 1;
+}
+
+/**
+ * @brief Libera a memória de um snapshot em escrita e fecha o arquivo.
+ * 
+ * @param writer O snapshot em escrita.
+ * 
+ * @return 1 se o arquivo foi fechado, 0 caso contrário.
+ */
+int destroySnapshotWriter(SnapshotWriter *writer) {
+	destroyHashTable(&writer->strings);
+	destroyArena(&writer->arena);
+	free(writer->buffer);
+	return close(writer->fd) == 0;
+}
+
+/**
+ * @brief Sincroniza com o disco o diretório que contém um arquivo, para que 
+ * a mudança de nome do arquivo sobreviva a uma falha do sistema.
+ * 
+ * @param path O caminho do arquivo, cortado no último '/' para obter o 
+ * diretório.
+ * 
+ * @return 1 em caso de sucesso, 0 se o diretório não puder ser sincronizado.
+ */
+int syncParentDirectory(char *path) {
+	char *slash = strrchr(path, '/');
+	const char *directory = ".";
+	int fd, result;
+	if (slash != NULL) {
+		slash[slash == path ? 1 : 0] = '\0';
+		directory = path;
+	}
+	if ((fd = open(directory, O_RDONLY)) < 0) return 0;
+	result = fsync(fd) == 0;
+	close(fd);
+	return result;
+}
+
+/**
+ * @brief Guarda o estado do sistema num snapshot. O arquivo é escrito num 
+ * temporário ao lado do destino e só o substitui depois de completo e 
+ * sincronizado com o disco; o diretório é sincronizado a seguir, pelo que 
+ * o diário só pode ser descartado depois de esta função ter sucesso.
+ * 
+ * @param vaccinationSystem O sistema de vacinação.
+ * @param path O caminho do snapshot.
+ * 
+ * @return 1 em caso de sucesso, 0 se o arquivo não puder ser escrito e -1 
+ * se faltar memória.
+ */
+int saveSnapshot(VaccinationSystem *vaccinationSystem, const char *path) {
+	SnapshotWriter writer;
+	char *temp = (char*)malloc(strlen(path) + sizeof(".tmp"));
+	int fd, result = -1;
+	if (temp == NULL) return -1;
+	strcpy(temp, path);
+	strcat(temp, ".tmp");
+	if ((fd = open(temp, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0) {
+		free(temp);
+		return 0;
+	}
+	if (initSnapshotWriter(&writer, fd)) {
+		result = collectSnapshotStrings(&writer, vaccinationSystem);
+		if (result == 1)
+			result = writeSnapshot(&writer, vaccinationSystem);
+		if (!destroySnapshotWriter(&writer) && result == 1) result = 0;
+	} else close(fd);
+	if (result == 1 && rename(temp, path) != 0) result = 0;
+	if (result != 1) unlink(temp);
+	else if (!syncParentDirectory(temp)) result = 0;
+	free(temp);
+	return result;
+}
+
+/**
+ * @brief Verifica o cabeçalho de um snapshot: a identificação, a versão, a 
+ * ordem dos bytes e se o tamanho das secções corresponde ao do arquivo.
+ * 
+ * @param header O cabeçalho.
+ * @param size O tamanho do arquivo.
+ * 
+ * @return 1 se o cabeçalho for válido, 0 caso contrário.
+ */
+int validSnapshotHeader(const SnapshotHeader *header, uint64_t size) {
+	uint64_t body;
+	if (size < sizeof(SnapshotHeader) || 
+		memcmp(header->magic, SNAPSHOT_MAGIC, 
+			sizeof(header->magic)) != 0 || 
+		header->version != SNAPSHOT_VERSION || 
+		header->byte_order != SNAPSHOT_BYTE_ORDER) return 0;
+	body = size - sizeof(SnapshotHeader);
+	if (header->record_count > body / sizeof(SnapshotRecord)) return 0;
+	body -= header->record_count * sizeof(SnapshotRecord);
+	if (header->batch_count > body / sizeof(SnapshotBatch)) return 0;
+	body -= header->batch_count * sizeof(SnapshotBatch);
+	if (header->vaccine_count > body / sizeof(uint32_t)) return 0;
+	body -= header->vaccine_count * sizeof(uint32_t);
+	return body == header->strings_size && 
+		header->strings_size <= (uint64_t)UINT32_MAX + 1;
+}
+
+/**
+ * @brief Verifica o código de verificação do corpo de um snapshot.
+ * 
+ * @param data O conteúdo do arquivo.
+ * @param size O tamanho do arquivo.
+ * 
+ * @return 1 se o código corresponder ao do cabeçalho, 0 caso contrário.
+ */
+int validSnapshotChecksum(const unsigned char *data, uint64_t size) {
+	const SnapshotHeader *header = (const SnapshotHeader*)data;
+	const unsigned char *body = data + sizeof(SnapshotHeader);
+	uint64_t length = size - sizeof(SnapshotHeader);
+	size_t tail = (size_t)(length & 7);
+	uint64_t state = checksumWords(SNAPSHOT_CHECKSUM_KEY, body, 
+		(size_t)length);
+	return checksumFinish(state, body + length - tail, tail, length) == 
+		header->checksum;
+}
+
+/**
+ * @brief Devolve uma string da tabela de strings de um snapshot.
+ * 
+ * @param strings A tabela de strings.
+ * @param size O tamanho da tabela.
+ * @param offset A posição da string.
+ * 
+ * @return A string, ou NULL se a posição estiver fora da tabela.
+ */
+const char* snapshotString(const char *strings, uint64_t size, 
+	uint32_t offset) {
+	return offset < size ? strings + offset : NULL;
+}
+
+/**
+ * @brief Repõe o catálogo de vacinas de um snapshot, pela ordem dos IDs.
+ * 
+ * @param vs O sistema de vacinação, ainda vazio.
+ * @param names As posições dos nomes das vacinas.
+ * @param header O cabeçalho do snapshot.
+ * @param strings A tabela de strings.
+ * 
+ * @return 1 em caso de sucesso, 0 se o snapshot for inválido e -1 se faltar 
+ * memória.
+ */
+int restoreSnapshotVaccines(VaccinationSystem *vs, const uint32_t *names, 
+	const SnapshotHeader *header, const char *strings) {
+	VaccinesHashTable *vaccines = vs->batches_ht->vaccines;
+	const char *name;
+	uint32_t i;
+	for (i = 0; i < header->vaccine_count; i++) {
+		name = snapshotString(strings, header->strings_size, names[i]);
+		if (name == NULL || searchVaccine(vaccines, name) != NULL)
+			return 0;
+		if (getOrInsertVaccine(vaccines, name) == NULL) return -1;
+	}
+	return 1;
+}
+
+/**
+ * @brief Repõe os lotes de um snapshot.
+ * 
+ * @param vs O sistema de vacinação.
+ * @param batches Os lotes do snapshot.
+ * @param header O cabeçalho do snapshot.
+ * @param strings A tabela de strings.
+ * 
+ * @return 1 em caso de sucesso, 0 se o snapshot for inválido e -1 se faltar 
+ * memória.
+ */
+int restoreSnapshotBatches(VaccinationSystem *vs, 
+	const SnapshotBatch *batches, const SnapshotHeader *header, 
+	const char *strings) {
+	BatchesHashTable *batchHashTable = vs->batches_ht;
+	const SnapshotBatch *batch;
+	const char *id;
+	uint64_t i, size = header->strings_size;
+	for (i = 0; i < header->batch_count; i++) {
+		batch = &batches[i];
+		id = snapshotString(strings, size, batch->batch);
+		if (id == NULL || !validBatchId(id) || 
+			batch->vaccine_id >= header->vaccine_count || 
+			batch->doses < 0 || batch->applications < 0 || 
+			searchBatchInSystem(batchHashTable, id) != NULL)
+			return 0;
+		if (!restoreBatchInSystem(batchHashTable, id, batch->date, 
+			batch->doses, batch->applications, 
+			vaccineById(batchHashTable->vaccines, 
+			(int)batch->vaccine_id)->name)) return -1;
+	}
+	return 1;
+}
+
+/**
+ * @brief Repõe os registros de vacinação de um snapshot, pela ordem 
+ * cronológica.
+ * 
+ * @param vs O sistema de vacinação.
+ * @param records Os registros do snapshot.
+ * @param header O cabeçalho do snapshot.
+ * @param strings A tabela de strings.
+ * 
+ * @return 1 em caso de sucesso, 0 se o snapshot for inválido e -1 se faltar 
+ * memória.
+ */
+int restoreSnapshotRecords(VaccinationSystem *vs, 
+	const SnapshotRecord *records, const SnapshotHeader *header, 
+	const char *strings) {
+	const SnapshotRecord *record;
+	const char *user, *batch_id;
+	BatchInfo *batch;
+	uint64_t i, next_seq = 0, size = header->strings_size;
+	int result;
+	for (i = 0; i < header->record_count; i++) {
+		record = &records[i];
+		user = snapshotString(strings, size, record->user);
+		batch_id = snapshotString(strings, size, record->batch);
+		batch = batch_id == NULL ? NULL : 
+			searchBatchInSystem(vs->batches_ht, batch_id);
+		if (user == NULL || batch == NULL || 
+			batch->applications == 0 || 
+			batch->vaccine_id != (int)record->vaccine_id || 
+			record->seq < next_seq || 
+			record->seq >= header->next_seq) return 0;
+		result = restoreVaccinationRecord(userRecords(vs, user), user, 
+			batch, record->date, record->seq);
+		if (result != 1) return result == 0 ? -1 : 0;
+		next_seq = record->seq + 1;
+	}
+	vs->next_seq = header->next_seq;
+	return 1;
+}
+
+/**
+ * @brief Repõe o estado do sistema a partir do conteúdo de um snapshot já 
+ * mapeado em memória.
+ * 
+ * @param vs O sistema de vacinação, ainda vazio.
+ * @param data O conteúdo do arquivo.
+ * @param size O tamanho do arquivo.
+ * 
+ * @return 1 em caso de sucesso, 0 se o snapshot for inválido e -1 se faltar 
+ * memória.
+ */
+int restoreSnapshot(VaccinationSystem *vs, const unsigned char *data, 
+	uint64_t size) {
+	const SnapshotHeader *header = (const SnapshotHeader*)data;
+	const unsigned char *section = data + sizeof(SnapshotHeader);
+	const SnapshotRecord *records = (const SnapshotRecord*)section;
+	const SnapshotBatch *batches;
+	const uint32_t *names;
+	const char *strings;
+	int result;
+	if (!validSnapshotHeader(header, size) || 
+		!validSnapshotChecksum(data, size)) return 0;
+	batches = (const SnapshotBatch*)(records + header->record_count);
+	names = (const uint32_t*)(batches + header->batch_count);
+	strings = (const char*)(names + header->vaccine_count);
+	if (header->strings_size > 0 && 
+		strings[header->strings_size - 1] != '\0') return 0;
+	result = restoreSnapshotVaccines(vs, names, header, strings);
+	if (result == 1)
+		result = restoreSnapshotBatches(vs, batches, header, strings);
+	if (result == 1)
+		result = restoreSnapshotRecords(vs, records, header, strings);
+	if (result != 1) return result;
+	setSystemDate(vs, header->current_date);
+	vs->journal.next_lsn = header->journal_lsn;
+	return 1;
+}
+
+/**
+ * @brief Carrega um snapshot num sistema de vacinação ainda vazio. O arquivo 
+ * é mapeado em memória e os lotes e registros são lidos diretamente dos 
+ * vetores de tamanho fixo, sem interpretar texto.
+ * 
+ * @param vaccinationSystem O sistema de vacinação.
+ * @param path O caminho do snapshot.
+ * 
+ * @return 1 em caso de sucesso, 0 se o arquivo não puder ser lido ou for 
+ * inválido e -1 se faltar memória.
+ */
+int loadSnapshot(VaccinationSystem *vaccinationSystem, const char *path) {
+	struct stat info;
+	void *data;
+	int fd = open(path, O_RDONLY), result;
+	if (fd < 0) return 0;
+	if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || 
+		(uint64_t)info.st_size < sizeof(SnapshotHeader)) {
+		close(fd);
+		return 0;
+	}
+	data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED) return 0;
+	result = restoreSnapshot(vaccinationSystem, (const unsigned char*)data, 
+		(uint64_t)info.st_size);
+	munmap(data, (size_t)info.st_size);
+	return result;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file snapshot.h
+ * @author Diogo Lobo (ist1109293)
+ * @brief Cabeçalho do snapshot binário do sistema de vacinação, que guarda 
+ * as vacinas, os lotes, os registros e a data atual num arquivo que pode 
+ * ser mapeado em memória e carregado sem interpretar texto.
+ * @date 2026-10-16
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdint.h>
+#include "system.h"
+
+/** Identificação dos arquivos de snapshot. */
+#define SNAPSHOT_MAGIC "IAEDSNAP"
+
+/** Versão do formato do snapshot. */
+#define SNAPSHOT_VERSION 2
+
+/** Marcador da ordem dos bytes de quem escreveu o snapshot. */
+#define SNAPSHOT_BYTE_ORDER 0x01020304u
+
+/** Chave do código de verificação do snapshot. */
+#define SNAPSHOT_CHECKSUM_KEY 0x9e3779b97f4a7c15ull
+
+/** Tamanho do buffer de escrita do snapshot, múltiplo de 8. */
+#define SNAPSHOT_BUFFER_SIZE (1 << 16)
+
+/** Capacidade inicial da arena das strings de um snapshot em escrita. */
+#define SNAPSHOT_ARENA_SIZE (1 << 16)
+
+/** Cabeçalho do snapshot. Seguem-se, por esta ordem, os registros, os 
+ * lotes, os nomes das vacinas e a tabela de strings; todas as referências a 
+ * strings são posições nesta tabela, pelo que o arquivo não depende do 
+ * endereço onde é carregado. */
+typedef struct SnapshotHeader {
+    char magic[8]; /** Sempre SNAPSHOT_MAGIC, sem '\0'. */
+    uint32_t version; /** Versão do formato, SNAPSHOT_VERSION. */
+    uint32_t byte_order; /** SNAPSHOT_BYTE_ORDER na ordem de quem o 
+    escreveu. */
+    uint32_t vaccine_count; /** Número de vacinas do catálogo. */
+    uint32_t current_date; /** Data atual do sistema. */
+    uint64_t batch_count; /** Número de lotes. */
+    uint64_t record_count; /** Número de registros de vacinação. */
+    uint64_t strings_size; /** Tamanho da tabela de strings em bytes. */
+    uint64_t next_seq; /** Número de sequência do próximo registro. */
+    uint64_t journal_lsn; /** Número da primeira mutação do diário que não 
+    está contida no snapshot. */
+    uint64_t checksum; /** Código de verificação de tudo o que se segue ao 
+    cabeçalho. */
+} SnapshotHeader;
+
+/** Registro de vacinação guardado no snapshot, pela ordem cronológica. */
+typedef struct SnapshotRecord {
+    uint64_t seq; /** Número de sequência do registro. */
+    uint32_t user; /** Posição do nome do usuário nas strings. */
+    uint32_t batch; /** Posição do ID do lote nas strings. */
+    uint32_t vaccine_id; /** ID da vacina no catálogo. */
+    uint32_t date; /** Data da vacinação. */
+} SnapshotRecord;
+
+/** Lote guardado no snapshot, pela ordem de data e ID. */
+typedef struct SnapshotBatch {
+    uint32_t batch; /** Posição do ID do lote nas strings. */
+    uint32_t vaccine_id; /** ID da vacina no catálogo. */
+    uint32_t date; /** Data de validade do lote. */
+    int32_t doses; /** Quantidade total de doses do lote. */
+    int32_t applications; /** Quantidade de doses aplicadas. */
+} SnapshotBatch;
+
+/** String já colocada na tabela de strings de um snapshot em escrita. */
+typedef struct SnapshotString {
+    const char *text; /** Texto da string. */
+    uint32_t offset; /** Posição da string na tabela. */
+    struct SnapshotString *next; /** String seguinte na tabela. */
+} SnapshotString;
+
+/** Estrutura que representa um snapshot em escrita. */
+typedef struct SnapshotWriter {
+    int fd; /** Descritor do arquivo temporário. */
+    unsigned char *buffer; /** Buffer de escrita. */
+    size_t used; /** Número de bytes no buffer. */
+    uint64_t written; /** Número de bytes escritos depois do cabeçalho. */
+    uint64_t checksum; /** Código de verificação dos blocos já escritos. */
+    int failed; /** 1 se alguma escrita falhou. */
+    Arena arena; /** Memória das strings da tabela. */
+    HashTable strings; /** Strings da tabela, indexadas pelo texto. */
+    SnapshotString *first; /** Primeira string da tabela. */
+    SnapshotString *last; /** Última string da tabela. */
+    uint64_t strings_size; /** Tamanho atual da tabela de strings. */
+} SnapshotWriter;
+
+int saveSnapshot(VaccinationSystem *vaccinationSystem, const char *path);
+
+int loadSnapshot(VaccinationSystem *vaccinationSystem, const char *path);
+
+#endif
@@ -10,56 +10,149 @@
 #include "batch.h"
 #include "records.h"
 #include "constants.h"
+#include "shard.h"
+#include "report.h"
 
 /**
- * @brief Libera a memória alocada para o sistema de vacinação e a data
+ * @brief Prepara cada escrita da saída do sistema no fluxo. Antes de 
+ * qualquer resposta chegar ao cliente, as mutações do diário ainda por 
+ * sincronizar são escritas e sincronizadas com o disco, para que nenhuma 
+ * mutação já confirmada se perca numa falha; depois são escritos os 
+ * relatórios pendentes. Com `--journal-sync 0` o diário só é sincronizado 
+ * nos checkpoints e no fim, sem esta garantia. Se a sincronização falhar, 
+ * o programa termina sem escrever a saída ainda por confirmar.
  * 
- * @param vs Sistema de vacinação a ser desalocado
- * @param date Data a ser desalocada
+ * @param context O sistema de vacinação.
  */
-void freeVaccionationSystemAndDate(VaccinationSystem* vs, Date date) {
-	free(vs);
-	free(date);
+void flushSystemOutput(void *context) {
+	VaccinationSystem *vs = (VaccinationSystem*)context;
+	if (vs->journal.group_size > 0 && !syncJournal(&vs->journal)) {
+		fprintf(stderr, "%s\n", 
+			!vs->pt ? EJOURNALWRITE : EJOURNALWRITEPT);
+		exit(1);
+	}
+	if (vs->reports != NULL) flushReports(vs->reports);
+}
+
+/**
+ * @brief Inicializa a arena de rascunho e o escritor da saída do sistema
+ * 
+ * @param vs Sistema de vacinação cujos buffers são inicializados
+ * 
+ * @return 1 em caso de sucesso, 0 em caso de falha
+ */
+int initSystemBuffers(VaccinationSystem* vs) {
+	if (!initArena(&vs->scratch, SCRATCH_ARENA_SIZE)) return 0;
+	if (!initOutput(&vs->output, stdout)) {
+		destroyArena(&vs->scratch);
+		return 0;
+	}
+	vs->output.before_flush = flushSystemOutput;
+	vs->output.context = vs;
+	return 1;
+}
+
+/**
+ * @brief Libera as partições dos registros de vacinação do sistema.
+ * 
+ * @param vs Sistema de vacinação cujas partições são liberadas
+ */
+void destroyRecordShards(VaccinationSystem* vs) {
+	int i;
+	for (i = 0; i < vs->shard_count; i++)
+		destroyVaccinationRecordsHashtable(vs->record_shards[i]);
+	free(vs->record_shards);
+	vs->record_shards = NULL;
+	vs->records_ht = NULL;
+}
+
+/**
+ * @brief Cria as partições dos registros de vacinação do sistema, todas 
+ * vazias. A primeira é também a tabela `records_ht`.
+ * 
+ * @param vs Sistema de vacinação cujas partições são criadas
+ * @param shard_count Número de partições
+ * 
+ * @return 1 em caso de sucesso, 0 em caso de falha
+ */
+int initRecordShards(VaccinationSystem* vs, int shard_count) {
+	int i;
+	vs->record_shards = (VaccinationRecordsHashtable**)calloc(shard_count, 
+		sizeof(VaccinationRecordsHashtable*));
+	vs->shard_count = 0;
+	if (vs->record_shards == NULL) return 0;
+	vs->shard_count = shard_count;
+	for (i = 0; i < shard_count; i++)
+		if ((vs->record_shards[i] = 
+			initVaccinationRecordsHashtable()) == NULL) {
+			destroyRecordShards(vs);
+			return 0;
+		}
+	vs->records_ht = vs->record_shards[0];
+	return 1;
+}
+
+/**
+ * @brief Liga as listas de objetos retirados dos lotes e dos registros às 
+ * épocas dos relatórios do sistema.
+ * 
+ * @param vs Sistema de vacinação cujas listas são ligadas
+ */
+void attachRetireLists(VaccinationSystem* vs) {
+	int i;
+	initEpochClock(&vs->epochs);
+	vs->reports = NULL;
+	vs->batches_ht->retired.clock = &vs->epochs;
+	for (i = 0; i < vs->shard_count; i++)
+		vs->record_shards[i]->retired.clock = &vs->epochs;
 }
 
 /**
  * @brief Inicializa o sistema de vacinação
  * 
  * Esta função aloca memória e inicializa as tabelas hash para os registros de 
- * vacinação e os lotes, além de definir a data atual do sistema para 
- * 01/01/2025.
+ * vacinação e os lotes, a arena de rascunho e o escritor da saída, além de 
+ * definir a data atual do sistema para 01/01/2025.
+ * 
+ * @param max_batches Número máximo de lotes no sistema, ou 0 para não haver
+ * limite.
+ * @param shard_count Número de partições dos registros de vacinação, entre 
+ * 1 e MAX_SHARDS.
+ * @param pt Indicador de idioma das mensagens de erro (1 para português).
  * 
  * @return Um ponteiro para o sistema de vacinação inicializado, 
  * ou NULL em caso de falha
  */
-VaccinationSystem* initVaccinationSystem() {
+VaccinationSystem* initVaccinationSystem(int max_batches, int shard_count, 
+	int pt) {
 	VaccinationSystem* vaccination_system = NULL;
 	BatchesHashTable *batches_ht = NULL;
-	VaccinationRecordsHashtable *records_ht = NULL;
-	Date current_date;
 	vaccination_system = (VaccinationSystem*)malloc(
 		sizeof(VaccinationSystem));
 	if (vaccination_system == NULL) return NULL;
-	current_date = (Date) malloc(sizeof(struct Date));
-	if (current_date == NULL) {
+	vaccination_system->current_date = createDate(1, JAN, 2025);
+	vaccination_system->next_seq = 0;
+	vaccination_system->shards = NULL;
+	vaccination_system->pt = pt;
+	initJournal(&vaccination_system->journal);
+	batches_ht = initBatchesHashTable(max_batches);
+	if (batches_ht == NULL) {
 		free(vaccination_system);
 		return NULL;
 	}
-	current_date->day = 1,current_date->month = 1,current_date->year = 2025;
-	vaccination_system->current_date = current_date;
-	batches_ht = initBatchesHashTable();
-	if (batches_ht == NULL) {
-		freeVaccionationSystemAndDate(vaccination_system, current_date);
+	vaccination_system->batches_ht = batches_ht;
+	if (!initRecordShards(vaccination_system, shard_count)) {
+		free(vaccination_system);
+		destroyBatchesHashTable(batches_ht);
 		return NULL;
 	}
-	vaccination_system->batches_ht = batches_ht;
-	records_ht = initVaccinationRecordsHashtable();
-	if (records_ht == NULL) {
-		freeVaccionationSystemAndDate(vaccination_system, current_date);
+	if (!initSystemBuffers(vaccination_system)) {
 		destroyBatchesHashTable(batches_ht);
+		destroyRecordShards(vaccination_system);
+		free(vaccination_system);
 		return NULL;
 	}
-	vaccination_system->records_ht = records_ht;
+	attachRetireLists(vaccination_system);
 	return vaccination_system;
 }
 
@@ -67,14 +160,73 @@ VaccinationSystem* initVaccinationSystem() {
  * @brief Destrói o sistema de vacinação
  * 
  * Libera a memória alocada para o sistema de vacinação, destruindo as tabelas 
- * hash associadas e liberando a memória da data atual.
+ * hash associadas e a arena de rascunho, escrevendo a saída pendente e 
+ * sincronizando o diário. As threads das partições, se existirem, terminam 
+ * antes os comandos que ainda tinham em curso e os relatórios pendentes 
+ * são escritos.
  * 
  * @param vaccinationSystem Sistema de vacinação a ser destruído
  */
 void destroyVaccinationSystem(VaccinationSystem* vaccinationSystem) {
 	if (vaccinationSystem == NULL) return;
+	destroyShardPool(vaccinationSystem);
+	destroyReportPool(vaccinationSystem);
+	closeJournal(&vaccinationSystem->journal);
 	destroyBatchesHashTable(vaccinationSystem->batches_ht);
-	destroyVaccinationRecordsHashtable(vaccinationSystem->records_ht);
-	free(vaccinationSystem->current_date);
+	destroyRecordShards(vaccinationSystem);
+	destroyArena(&vaccinationSystem->scratch);
+	destroyOutput(&vaccinationSystem->output);
 	free(vaccinationSystem);
 }
+
+/**
+ * @brief Devolve a partição dos registros de vacinação de um usuário, 
+ * escolhida pelo hash do seu nome.
+ * 
+ * @param vs Sistema de vacinação
+ * @param user_name Nome do usuário
+ * 
+ * @return A tabela de registros da partição do usuário
+ */
+VaccinationRecordsHashtable* userRecords(VaccinationSystem* vs, 
+	const char* user_name) {
+	if (vs->shard_count == 1) return vs->records_ht;
+	return vs->record_shards[hashString(user_name, SHARD_HASH_SEED) % 
+		(unsigned)vs->shard_count];
+}
+
+/**
+ * @brief Insere um registro de vacinação na partição do usuário, com o 
+ * número de sequência global do sistema, que só avança se o registro for 
+ * inserido.
+ * 
+ * @param vs Sistema de vacinação
+ * @param user_name Nome do usuário
+ * @param batch Lote aplicado
+ * @param vaccination_date Data da vacinação
+ * 
+ * @return O resultado de `insertVaccinationRecord`: 1 em caso de sucesso, 
+ * 2 se o usuário já foi vacinado nessa data e 0 se faltar memória
+ */
+int insertUserRecord(VaccinationSystem* vs, const char* user_name, 
+	BatchInfo* batch, Date vaccination_date) {
+	VaccinationRecordsHashtable *records = userRecords(vs, user_name);
+	int result;
+	records->next_seq = vs->next_seq;
+	result = insertVaccinationRecord(records, user_name, batch, 
+		vaccination_date);
+	if (result == 1) vs->next_seq++;
+	return result;
+}
+
+/**
+ * @brief Avança a data atual do sistema, retirando do uso os lotes que 
+ * expiraram entretanto.
+ * 
+ * @param vs Sistema de vacinação
+ * @param date A nova data atual, igual ou posterior à anterior
+ */
+void setSystemDate(VaccinationSystem* vs, Date date) {
+	vs->current_date = date;
+	expireBatches(vs->batches_ht, date);
+}
@@ -11,21 +11,60 @@
 
 #include "batch.h"
 #include "records.h"
+#include "arena.h"
+#include "output.h"
+#include "journal.h"
+
+/** Semente do hash que escolhe a partição dos registros de um usuário. */
+#define SHARD_HASH_SEED 0x2545f4914f6cdd1dull
+
+struct ShardPool;
+struct ReportPool;
 
 /**
  * @brief Estrutura que representa o sistema de vacinação
  * 
- * Contém as tabelas hash para os lotes de vacinas, os registros de vacinação 
- * e a data atual do sistema.
+ * Contém as tabelas hash para os lotes de vacinas, os registros de vacinação,
+ * a data atual do sistema, a arena de rascunho dos comandos, o escritor da
+ * saída, o diário das mutações e as épocas dos relatórios. Os registros 
+ * podem estar divididos em partições pelo hash do nome do usuário, cada uma 
+ * com a sua tabela.
  */
 typedef struct VaccinationSystem {
     BatchesHashTable* batches_ht; /** Tabela hash para os lotes de vacina */
     VaccinationRecordsHashtable* records_ht; /** Tabela hash para os 
+    registros de vacinação; é a primeira partição */
+    VaccinationRecordsHashtable** record_shards; /** Partições dos 
     registros de vacinação */
+    int shard_count; /** Número de partições dos registros */
+    struct ShardPool* shards; /** Threads das partições, ou NULL se todos 
+    os comandos correm na thread principal */
     Date current_date; /** Data atual do sistema de vacinação */
+    unsigned long long next_seq; /** Número de sequência do próximo 
+    registro de vacinação, dado sempre pela thread principal */
+    Arena scratch; /** Arena dos valores temporários de cada comando */
+    Output output; /** Escritor com buffer de toda a saída do sistema */
+    Journal journal; /** Diário das mutações, desativado se o programa não 
+    tiver a opção `--journal` */
+    EpochClock epochs; /** Épocas dos relatórios, que adiam a liberação dos 
+    lotes e registros removidos */
+    struct ReportPool* reports; /** Threads dos relatórios, ou NULL se ainda 
+    não foram precisas */
+    int pt; /** Indicador de idioma das mensagens de erro */
 } VaccinationSystem;
 
-VaccinationSystem* initVaccinationSystem();
+VaccinationSystem* initVaccinationSystem(int max_batches, int shard_count, 
+int pt);
 void destroyVaccinationSystem(VaccinationSystem* vaccinationSystem);
 
+void flushSystemOutput(void *context);
+
+VaccinationRecordsHashtable* userRecords(VaccinationSystem* vs, 
+const char* user_name);
+
+void setSystemDate(VaccinationSystem* vs, Date date);
+
+int insertUserRecord(VaccinationSystem* vs, const char* user_name, 
+BatchInfo* batch, Date vaccination_date);
+
 #endif
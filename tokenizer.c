@@ -0,0 +1,230 @@
+/**
+ * @file tokenizer.c
+ * @author Diogo Lobo (ist1109293)
+ * @brief Implementação do analisador de comandos numa só passagem.
+ * @date 2026-10-16
+ */
+
+#include <ctype.h>
+#include <limits.h>
+#include "constants.h"
+#include "tokenizer.h"
+
+/**
+ * @brief Lê um argumento a partir de uma posição da linha e termina-o em 
+ * '\0'. Um argumento que começa por aspas estende-se até as aspas seguintes
+ * e pode conter espaços; caso contrário termina no próximo espaço.
+ * 
+ * @param line A linha do comando.
+ * @param i A posição onde o argumento começa.
+ * @param length O comprimento da linha.
+ * @param token O argumento a preencher.
+ * 
+ * @return A posição seguinte ao fim do argumento.
+ */
+size_t readToken(char *line, size_t i, size_t length, Token *token) {
+	size_t start;
+	char quote = line[i] == '"';
+	start = i + quote;
+	for (i = start; i < length; i++)
+		if (quote ? line[i] == '"' : isspace((unsigned char)line[i]))
+			break;
+	token->text = line + start;
+	token->length = i - start;
+	if (i < length) line[i++] = '\0';
+	return i;
+}
+
+/**
+ * @brief Divide uma linha de comando em argumentos, separados por espaços.
+ * O primeiro argumento é o próprio comando. Se a linha tiver mais do que
+ * max_tokens argumentos, o último contém o resto da linha tal como está.
+ * 
+ * @param line A linha do comando, terminada em '\0'.
+ * @param length O comprimento da linha.
+ * @param tokens Vetor onde são guardados os argumentos, com espaço para 
+ * max_tokens elementos.
+ * @param max_tokens O número máximo de argumentos.
+ * 
+ * @return O número de argumentos lidos, incluindo o comando.
+ */
+int tokenizeCommand(char *line, size_t length, Token *tokens, 
+	int max_tokens) {
+	size_t i = 0;
+	int count = 0;
+	while (count < max_tokens) {
+		while (i < length && isspace((unsigned char)line[i])) i++;
+		if (i >= length) break;
+		if (count == max_tokens - 1 && max_tokens > 1) {
+			tokens[count].text = line + i;
+			tokens[count++].length = length - i;
+			break;
+		}
+		i = readToken(line, i, length, &tokens[count++]);
+	}
+	return count;
+}
+
+/**
+ * @brief Converte o prefixo numérico de um texto num inteiro, como "%d".
+ * 
+ * @param text O texto a converter.
+ * @param end O fim do texto.
+ * @param value Onde é guardado o valor lido.
+ * 
+ * @return A posição seguinte ao número, ou NULL se não houver número.
+ */
+const char* parseInt(const char *text, const char *end, int *value) {
+	long long result = 0;
+	int negative = 0;
+	if (text < end && (*text == '-' || *text == '+'))
+		negative = *text++ == '-';
+	if (text == end || !isdigit((unsigned char)*text)) return NULL;
+	while (text < end && isdigit((unsigned char)*text)) {
+		if (result <= INT_MAX) result = result * 10 + (*text - '0');
+		text++;
+	}
+	if (result > INT_MAX) result = INT_MAX;
+	*value = (int)(negative ? -result : result);
+	return text;
+}
+
+/**
+ * @brief Converte um argumento inteiro.
+ * 
+ * @param token O argumento.
+ * @param value Onde é guardado o valor lido.
+ * 
+ * @return 1 se o argumento é um inteiro completo, 0 caso contrário.
+ */
+int tokenInt(const Token *token, int *value) {
+	const char *end = token->text + token->length;
+	return parseInt(token->text, end, value) == end;
+}
+
+/**
+ * @brief Converte um argumento no formato dd-mm-aaaa numa data. O argumento
+ * tem de ser lido até ao fim; caso contrário a data fica com zero em todos 
+ * os campos, que nunca é uma data válida.
+ * 
+ * @param token O argumento.
+ * @param date Onde é guardada a data lida.
+ * 
+ * @return 1 se o argumento é uma data completa, 0 caso contrário.
+ */
+int tokenDate(const Token *token, Date *date) {
+	const char *text = token->text, *end = token->text + token->length;
+	int fields[3] = {0, 0, 0}, count = 0;
+	while (count < 3 && text != NULL) {
+		if (count > 0 && (text == end || *text++ != '-')) break;
+		text = parseInt(text, end, &fields[count]);
+		if (text != NULL) count++;
+	}
+	if (count < 3 || text != end) fields[0] = fields[1] = fields[2] = 0;
+	*date = createDate(fields[0], fields[1], fields[2]);
+	return count == 3 && text == end;
+}
+
+/**
+ * @brief Salta os espaços a partir de uma posição do texto.
+ * 
+ * @param text A posição inicial.
+ * @param end O fim do texto.
+ * 
+ * @return A primeira posição que não é um espaço.
+ */
+char* skipBlank(char *text, const char *end) {
+	while (text < end && isspace((unsigned char)*text)) text++;
+	return text;
+}
+
+/**
+ * @brief Lê o ID do lote do comando `c`, como "%21[A-F0-9]": até 
+ * MAX_BATCH_NAME_SIZE + 1 dígitos hexadecimais maiúsculos, depois dos 
+ * espaços.
+ * 
+ * @param text A posição onde começa a leitura.
+ * @param end O fim da linha.
+ * @param token O argumento a preencher com o ID lido.
+ * 
+ * @return A posição seguinte ao ID, ou NULL se não houver nenhum dígito.
+ */
+char* scanBatchId(char *text, const char *end, Token *token) {
+	char *start = skipBlank(text, end);
+	text = start;
+	while (text < end && text - start <= MAX_BATCH_NAME_SIZE && 
+		(isdigit((unsigned char)*text) || 
+		(*text >= 'A' && *text <= 'F'))) text++;
+	if (text == start) return NULL;
+	token->text = start;
+	token->length = (size_t)(text - start);
+	return text;
+}
+
+/**
+ * @brief Lê os números do comando `c` a seguir ao ID do lote, como 
+ * " %d-%d-%d %d": o dia, o mês, o ano e as doses. Cada número pode ser 
+ * precedido de espaços, mas os separadores '-' têm de vir logo a seguir.
+ * 
+ * @param text A posição a seguir ao ID do lote.
+ * @param end O fim da linha.
+ * @param fields Onde são guardados os números lidos, com espaço para 4.
+ * @param count Onde é guardado o número de números lidos.
+ * 
+ * @return A posição seguinte ao último número lido.
+ */
+char* scanCreateBatchNumbers(char *text, const char *end, int *fields, 
+	int *count) {
+	const char *next;
+	int dash;
+	for (*count = 0; *count < 4; (*count)++) {
+		dash = *count == 1 || *count == 2;
+		if (dash && (text == end || *text != '-')) break;
+		next = parseInt(skipBlank(text + dash, end), end, 
+			&fields[*count]);
+		if (next == NULL) break;
+		text = (char*)next;
+	}
+	return text;
+}
+
+/**
+ * @brief Lê o comando `c` diretamente da linha, com o mesmo resultado de 
+ * "c %21[A-F0-9] %d-%d-%d %d %51[^\n]": a leitura para no primeiro campo 
+ * mal formado e o que sobra de um campo passa para o seguinte. O ID do lote
+ * fica em tokens[1] e o nome da vacina, até MAX_VACCINE_NAME_SIZE + 1 
+ * caracteres do resto da linha, em tokens[4], ambos terminados em '\0' no 
+ * lugar; os argumentos não lidos ficam vazios.
+ * 
+ * @param line A linha do comando, terminada em '\0'.
+ * @param length O comprimento da linha.
+ * @param tokens Vetor com espaço para CREATE_BATCH_TOKENS argumentos.
+ * @param date Onde é guardada a data do lote.
+ * @param doses Onde é guardado o número de doses.
+ * 
+ * @return O número de campos lidos, entre 0 e 6.
+ */
+int scanCreateBatch(char *line, size_t length, Token *tokens, Date *date, 
+	int *doses) {
+	char *end = line + length, *text;
+	int fields[4] = {0, 0, 0, 0}, count = 0, i;
+	for (i = 0; i < CREATE_BATCH_TOKENS; i++) {
+		tokens[i].text = end;
+		tokens[i].length = 0;
+	}
+	text = scanBatchId(line + 1, end, &tokens[1]);
+	if (text != NULL) text = scanCreateBatchNumbers(text, end, fields, 
+		&count);
+	if (count == 4 && (text = skipBlank(text, end)) < end) {
+		tokens[4].text = text;
+		tokens[4].length = (size_t)(end - text);
+		if (tokens[4].length > MAX_VACCINE_NAME_SIZE + 1)
+			tokens[4].length = MAX_VACCINE_NAME_SIZE + 1;
+		count++;
+	}
+	tokens[1].text[tokens[1].length] = '\0';
+	tokens[4].text[tokens[4].length] = '\0';
+	*date = createDate(fields[0], fields[1], fields[2]);
+	*doses = fields[3];
+	return text != NULL ? count + 1 : 0;
+}
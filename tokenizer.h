@@ -0,0 +1,34 @@
+/**
+ * @file tokenizer.h
+ * @author Diogo Lobo (ist1109293)
+ * @brief Cabeçalho do analisador de comandos. Cada linha é dividida numa só
+ * passagem em argumentos, simples ou entre aspas, que apontam para a própria
+ * linha, e os argumentos são depois convertidos em inteiros e datas sem
+ * recorrer a sscanf.
+ * @date 2026-10-16
+ */
+
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <stddef.h>
+#include "date.h"
+
+/** Estrutura que representa um argumento de um comando. O texto aponta
+ * para a linha do comando e é terminado em '\0' no lugar. */
+typedef struct Token {
+    char *text; /** Texto do argumento, sem as aspas. */
+    size_t length; /** Comprimento do argumento. */
+} Token;
+
+int tokenizeCommand(char *line, size_t length, Token *tokens, 
+int max_tokens);
+
+int tokenInt(const Token *token, int *value);
+
+int tokenDate(const Token *token, Date *date);
+
+int scanCreateBatch(char *line, size_t length, Token *tokens, Date *date, 
+int *doses);
+
+#endif
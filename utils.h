@@ -9,13 +9,14 @@
 #ifndef UTILS_H
 #define UTILS_H
 
-void printError(const char* error, const char* error_pt, int pt);
-void printErrorFormated(const char* error,  
-const char* error_pt, int pt, char* info);
-int validBatch(char* batch, int num_args, int pt);
-int validName(char* name, int num_args, int pt);
-int validDosesNumber(int doses_number, int pt);
-int nextPrime(int num);
-int countArguments(const char *input);
+#include "output.h"
+
+void printError(Output* out, const char* error, const char* error_pt, int pt);
+void printErrorFormated(Output* out, const char* error,  
+const char* error_pt, int pt, const char* info);
+int validBatchId(const char* batch);
+int validBatch(const char* batch, int num_args);
+int validName(const char* name, int num_args);
+int validDosesNumber(Output* out, int doses_number, int pt);
 
 #endif
@@ -0,0 +1,191 @@
+/**
+ * @file vaccine.c
+ * @author Diogo Lobo (ist1109293)
+ * @brief Implementação do catálogo de vacinas: tabela de hash indexada pelo 
+ * nome da vacina, vetor indexado pelo ID atribuído a cada nome e, para cada 
+ * vacina, uma heap mínima dos lotes que ainda têm doses disponíveis, ordenada 
+ * por data de validade e ID do lote.
+ * @date 2026-10-16
+ */
+
+/** Expõe strdup, que é POSIX, mesmo quando se compila em C99 estrito. */
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <string.h>
+#include "vaccine.h"
+#include "batch.h"
+
+/** Capacidade inicial do catálogo de vacinas indexado por ID. */
+#define INITIAL_CATALOG_CAPACITY 16
+
+/**
+ * @brief Devolve a chave de uma vacina na tabela de hash, o seu nome.
+ *
+ * @param entry A vacina.
+ *
+ * @return O nome da vacina.
+ */
+const char* vaccineKey(const void *entry) {
+	return ((const Vaccine*)entry)->name;
+}
+
+/**
+ * @brief Inicializa uma nova tabela de hash para as vacinas.
+ *
+ * @return Ponteiro para a tabela inicializada, ou NULL caso ocorra um erro
+ * de alocação de memória.
+ */
+VaccinesHashTable* initVaccinesHashTable() {
+	VaccinesHashTable *ht;
+	ht = (VaccinesHashTable *)malloc(sizeof(VaccinesHashTable));
+	if (!ht) return NULL;
+	if (!initHashTable(&ht->vaccines, vaccineKey)) {
+		free(ht);
+		return NULL;
+	}
+	ht->catalog = NULL;
+	ht->catalog_capacity = 0;
+	ht->vaccine_count = 0;
+	return ht;
+}
+
+/**
+ * @brief Procura uma vacina pelo nome.
+ *
+ * @param ht A tabela de hash das vacinas.
+ * @param vaccine_name O nome da vacina a procurar.
+ *
+ * @return Ponteiro para a vacina, ou NULL se não existir.
+ */
+Vaccine* searchVaccine(VaccinesHashTable *ht, const char *vaccine_name) {
+	return hashTableFind(&ht->vaccines, vaccine_name);
+}
+
+/**
+ * @brief Devolve a vacina com o ID indicado.
+ *
+ * @param ht A tabela de hash das vacinas.
+ * @param id O ID da vacina.
+ *
+ * @return Ponteiro para a vacina.
+ */
+Vaccine* vaccineById(VaccinesHashTable *ht, int id) {
+	return ht->catalog[id];
+}
+
+/**
+ * @brief Garante que o catálogo tem espaço para mais uma vacina.
+ *
+ * @param ht A tabela de hash das vacinas.
+ *
+ * @return 1 se existe espaço, 0 em caso de erro de memória.
+ */
+int growVaccinesCatalog(VaccinesHashTable *ht) {
+	Vaccine **new_catalog;
+	int new_capacity;
+	if (ht->vaccine_count < ht->catalog_capacity) return 1;
+	new_capacity = ht->catalog_capacity ? ht->catalog_capacity * 2 :
+		INITIAL_CATALOG_CAPACITY;
+	new_catalog = (Vaccine **)realloc(ht->catalog,
+		new_capacity * sizeof(Vaccine *));
+	if (!new_catalog) return 0;
+	ht->catalog = new_catalog;
+	ht->catalog_capacity = new_capacity;
+	return 1;
+}
+
+/**
+ * @brief Devolve a vacina com o nome indicado, registrando-a no catálogo com
+ * um novo ID se ainda não existir.
+ *
+ * @param ht A tabela de hash das vacinas.
+ * @param vaccine_name O nome da vacina.
+ *
+ * @return Ponteiro para a vacina, ou NULL em caso de erro de memória.
+ */
+Vaccine* getOrInsertVaccine(VaccinesHashTable *ht, const char *vaccine_name) {
+	Vaccine *vaccine;
+	vaccine = searchVaccine(ht, vaccine_name);
+	if (vaccine) return vaccine;
+	if (!growVaccinesCatalog(ht)) return NULL;
+	vaccine = (Vaccine *)malloc(sizeof(Vaccine));
+	if (!vaccine) return NULL;
+	vaccine->name = strdup(vaccine_name);
+	if (!vaccine->name || !hashTableInsert(&ht->vaccines, vaccine)) {
+		free(vaccine->name);
+		free(vaccine);
+		return NULL;
+	}
+	initBatchHeap(&vaccine->heap, BATCH_HEAP_VACCINE_LANE);
+	initBatchIndex(&vaccine->batches, BATCH_INDEX_VACCINE_LANE);
+	memset(&vaccine->stock, 0, sizeof(VaccineStock));
+	vaccine->id = ht->vaccine_count++;
+	ht->catalog[vaccine->id] = vaccine;
+	return vaccine;
+}
+
+/**
+ * @brief Insere um lote na heap de lotes utilizáveis de uma vacina, somando 
+ * as suas doses disponíveis às da vacina.
+ *
+ * @param vaccine A vacina do lote.
+ * @param batch_info O lote a inserir.
+ *
+ * @return 1 se o lote foi inserido, 0 em caso de erro de memória.
+ */
+int pushBatchToVaccine(Vaccine *vaccine, struct BatchInfo *batch_info) {
+	if (!pushToBatchHeap(&vaccine->heap, batch_info)) return 0;
+	vaccine->stock.batches++;
+	vaccine->stock.available += batch_info->doses - 
+		batch_info->applications;
+	return 1;
+}
+
+/**
+ * @brief Retira um lote da heap de lotes utilizáveis da sua vacina, cujas 
+ * doses disponíveis deixam de contar. Não faz nada se o lote já não estiver 
+ * na heap.
+ *
+ * @param vaccine A vacina do lote.
+ * @param batch_info O lote a retirar.
+ */
+void removeBatchFromVaccine(Vaccine *vaccine, struct BatchInfo *batch_info) {
+	if (batch_info->heap_index[BATCH_HEAP_VACCINE_LANE] < 0) return;
+	vaccine->stock.batches--;
+	vaccine->stock.available -= batch_info->doses - 
+		batch_info->applications;
+	removeFromBatchHeap(&vaccine->heap, batch_info);
+}
+
+/**
+ * @brief Devolve o lote válido mais antigo de uma vacina. Os lotes que
+ * expiram são retirados da heap quando a data do sistema avança 
+ * (`expireBatches`), pelo que o topo da heap é sempre utilizável.
+ *
+ * @param vaccine A vacina pretendida.
+ *
+ * @return O lote com validade mais antiga ainda válido e com doses
+ * disponíveis, ou NULL se não existir.
+ */
+struct BatchInfo* oldestValidBatchOfVaccine(Vaccine *vaccine) {
+	return topOfBatchHeap(&vaccine->heap);
+}
+
+/**
+ * @brief Destrói a tabela de hash das vacinas, liberando toda a memória
+ * alocada. Os lotes referenciados pelas heaps não são liberados.
+ *
+ * @param ht A tabela de hash das vacinas.
+ */
+void destroyVaccinesHashTable(VaccinesHashTable *ht) {
+	int i;
+	if (ht == NULL) return;
+	for (i = 0; i < ht->vaccine_count; i++) {
+		destroyBatchHeap(&ht->catalog[i]->heap);
+		free(ht->catalog[i]->name);
+		free(ht->catalog[i]);
+	}
+	free(ht->catalog);
+	destroyHashTable(&ht->vaccines);
+	free(ht);
+}
@@ -0,0 +1,71 @@
+/**
+ * @file vaccine.h
+ * @author Diogo Lobo (ist1109293)
+ * @brief Cabeçalho do catálogo de vacinas. Cada nome de vacina é registrado
+ * uma única vez e recebe um ID inteiro compacto, compartilhado pelos lotes e
+ * pelos registros de vacinação. Cada vacina mantém ainda uma fila de
+ * prioridade (heap mínima) com os seus lotes utilizáveis, ordenados por data
+ * de validade e ID do lote, para que o comando `a` escolha o lote a aplicar
+ * (FEFO - first expired, first out) em tempo logarítmico.
+ * @date 2026-10-16
+ */
+
+#ifndef VACCINE_H
+#define VACCINE_H
+
+#include "date.h"
+#include "hashtable.h"
+#include "batchindex.h"
+#include "batchheap.h"
+
+struct BatchInfo;
+
+/** Contadores das doses de uma vacina, atualizados a cada alteração dos 
+ * seus lotes, para responder ao comando `e` sem percorrer os lotes. */
+typedef struct VaccineStock {
+    int doses; /** Doses de todos os lotes da vacina no sistema. */
+    int applications; /** Doses aplicadas desses lotes. */
+    int available; /** Doses disponíveis nos lotes utilizáveis. */
+    int batches; /** Número de lotes utilizáveis: com doses disponíveis e 
+    dentro da validade. */
+} VaccineStock;
+
+/** Estrutura que representa uma vacina e os seus lotes utilizáveis. */
+typedef struct Vaccine {
+    int id; /** ID da vacina no catálogo. */
+    char *name; /** Nome da vacina. */
+    BatchHeap heap; /** Heap mínima de lotes com doses disponíveis e 
+    ainda válidos, ordenada por data e ID do lote. */
+    BatchIndex batches; /** Índice ordenado de todos os lotes da vacina. */
+    VaccineStock stock; /** Contadores das doses da vacina. */
+} Vaccine;
+
+/** Estrutura que representa o catálogo das vacinas conhecidas, indexado 
+ * pelo nome (tabela de hash) e pelo ID. */
+typedef struct VaccinesHashTable {
+    HashTable vaccines; /** Tabela de hash das vacinas, indexada pelo 
+    nome. */
+    Vaccine **catalog; /** Vetor de vacinas indexado pelo ID. */
+    int catalog_capacity; /** Capacidade alocada para o catálogo. */
+    int vaccine_count; /** Número de vacinas armazenadas na tabela. */
+} VaccinesHashTable;
+
+VaccinesHashTable* initVaccinesHashTable();
+
+Vaccine* searchVaccine(VaccinesHashTable *vaccinesHashTable,
+const char *vaccine_name);
+
+Vaccine* vaccineById(VaccinesHashTable *vaccinesHashTable, int id);
+
+Vaccine* getOrInsertVaccine(VaccinesHashTable *vaccinesHashTable,
+const char *vaccine_name);
+
+int pushBatchToVaccine(Vaccine *vaccine, struct BatchInfo *batch_info);
+
+void removeBatchFromVaccine(Vaccine *vaccine, struct BatchInfo *batch_info);
+
+struct BatchInfo* oldestValidBatchOfVaccine(Vaccine *vaccine);
+
+void destroyVaccinesHashTable(VaccinesHashTable *vaccinesHashTable);
+
+#endif